@@ -0,0 +1,232 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/arena_allocator.hpp>
+#include <primal/buffer.hpp>
+#include <primal/cache_line.hpp>
+#include <primal/large_page_allocator.hpp>
+#include <primal/pool_allocator.hpp>
+#include <primal/rigid_vector.hpp>
+#include <primal/tracking_allocator.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	constexpr size_t kSmallCount = 256;
+	constexpr size_t kLargeCount = 16;
+
+	template <typename A>
+	void allocateSmall(benchmark::State& state)
+	{
+		const auto size = static_cast<size_t>(state.range(0));
+		for (auto _ : state)
+		{
+			PRIMAL_ARENA_SCOPE();
+			for (size_t i = 0; i < kSmallCount; ++i)
+			{
+				primal::RigidVector<size_t, A> vector;
+				vector.reserve(size);
+				for (size_t j = 0; j < size; ++j)
+					vector.emplace_back(j);
+				benchmark::DoNotOptimize(vector.data());
+			}
+		}
+	}
+
+	template <typename A>
+	void allocateLarge(benchmark::State& state)
+	{
+		const auto size = static_cast<size_t>(state.range(0));
+		for (auto _ : state)
+		{
+			PRIMAL_ARENA_SCOPE();
+			for (size_t i = 0; i < kLargeCount; ++i)
+			{
+				primal::Buffer<std::byte, A> buffer{ size };
+				buffer.data()[0] = std::byte{ 1 };
+				buffer.data()[size - 1] = std::byte{ 1 };
+				benchmark::DoNotOptimize(buffer.data());
+			}
+		}
+	}
+
+	void Allocator_Small(benchmark::State& state) { allocateSmall<primal::Allocator>(state); }
+	void ArenaAllocator_Small(benchmark::State& state) { allocateSmall<primal::ArenaAllocator<>>(state); }
+	void Allocator_Large(benchmark::State& state) { allocateLarge<primal::Allocator>(state); }
+	void ArenaAllocator_Large(benchmark::State& state) { allocateLarge<primal::ArenaAllocator<>>(state); }
+}
+
+BENCHMARK(Allocator_Small)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(ArenaAllocator_Small)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(Allocator_Large)->RangeMultiplier(4)->Range(1 << 16, 1 << 22);
+BENCHMARK(ArenaAllocator_Large)->RangeMultiplier(4)->Range(1 << 16, 1 << 22);
+
+namespace
+{
+	constexpr size_t kMaxPairs = 4;
+	constexpr size_t kBatchSize = 256;
+
+	struct alignas(primal::kCacheLineSize) Slot
+	{
+		std::atomic<void*> _pointer{ nullptr };
+	};
+
+	Slot slots[kMaxPairs][kBatchSize];
+
+	// Even threads allocate nodes and pass them to the next odd thread which frees them.
+	template <typename A>
+	void produceConsume(benchmark::State& state)
+	{
+		const auto size = static_cast<size_t>(state.range(0));
+		const auto pairIndex = static_cast<size_t>(state.thread_index() / 2);
+		auto& pairSlots = slots[pairIndex];
+		if (state.thread_index() % 2 == 0)
+		{
+			for (auto _ : state)
+				for (auto& slot : pairSlots)
+				{
+					const auto pointer = A::allocate(size);
+					while (slot._pointer.load(std::memory_order_acquire))
+						std::this_thread::yield();
+					slot._pointer.store(pointer, std::memory_order_release);
+				}
+		}
+		else
+		{
+			for (auto _ : state)
+				for (auto& slot : pairSlots)
+				{
+					void* pointer;
+					while (!(pointer = slot._pointer.exchange(nullptr, std::memory_order_acquire)))
+						std::this_thread::yield();
+					A::deallocate(pointer);
+				}
+		}
+	}
+
+	// Every thread allocates and frees its own nodes.
+	template <typename A>
+	void churn(benchmark::State& state)
+	{
+		const auto size = static_cast<size_t>(state.range(0));
+		void* pointers[kBatchSize];
+		for (auto _ : state)
+		{
+			for (auto& pointer : pointers)
+				pointer = A::allocate(size);
+			benchmark::DoNotOptimize(pointers);
+			for (const auto pointer : pointers)
+				A::deallocate(pointer);
+		}
+	}
+
+	void Allocator_ProduceConsume(benchmark::State& state) { produceConsume<primal::Allocator>(state); }
+	void PoolAllocator_ProduceConsume(benchmark::State& state) { produceConsume<primal::PoolAllocator>(state); }
+	void Allocator_Churn(benchmark::State& state) { churn<primal::Allocator>(state); }
+	void PoolAllocator_Churn(benchmark::State& state) { churn<primal::PoolAllocator>(state); }
+	void TrackingAllocator_Churn(benchmark::State& state) { churn<primal::TrackingAllocator<primal::Allocator, struct ChurnTag>>(state); }
+}
+
+BENCHMARK(Allocator_ProduceConsume)->Arg(16)->Arg(64)->Arg(256)->ThreadRange(2, 2 * kMaxPairs)->UseRealTime();
+BENCHMARK(PoolAllocator_ProduceConsume)->Arg(16)->Arg(64)->Arg(256)->ThreadRange(2, 2 * kMaxPairs)->UseRealTime();
+BENCHMARK(Allocator_Churn)->Arg(16)->Arg(64)->Arg(256)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(PoolAllocator_Churn)->Arg(16)->Arg(64)->Arg(256)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(TrackingAllocator_Churn)->Arg(16)->Arg(64)->Arg(256)->ThreadRange(1, 8)->UseRealTime();
+
+namespace
+{
+	// Allocator without allocateZeroed() and reallocate() hooks.
+	struct PlainAllocator
+	{
+		[[nodiscard]] static void* allocate(size_t size)
+		{
+			auto memory = primal::Allocator::allocate(size);
+			benchmark::DoNotOptimize(memory); // Prevent malloc+memset from being fused into calloc.
+			return memory;
+		}
+
+		static void deallocate(void* memory) noexcept { primal::Allocator::deallocate(memory); }
+	};
+
+	size_t residentBytes() noexcept
+	{
+		size_t pages = 0;
+#ifdef __linux__
+		if (const auto file = std::fopen("/proc/self/statm", "r"))
+		{
+			if (std::fscanf(file, "%*s %zu", &pages) != 1)
+				pages = 0;
+			std::fclose(file);
+		}
+#endif
+		return pages * 4096;
+	}
+
+	// Allocates a zeroed buffer and writes to one byte in every 64 pages.
+	template <typename A>
+	void allocateSparse(benchmark::State& state)
+	{
+		constexpr size_t kTouchStride = 64 * 4096;
+		const auto size = static_cast<size_t>(state.range(0));
+		double residentGrowth = 0;
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			const auto residentBefore = residentBytes();
+			state.ResumeTiming();
+			primal::Buffer<std::byte, primal::CleanAllocator<A>> buffer{ size };
+			for (size_t i = 0; i < size; i += kTouchStride)
+				buffer.data()[i] = std::byte{ 1 };
+			benchmark::DoNotOptimize(buffer.data());
+			state.PauseTiming();
+			residentGrowth += static_cast<double>(residentBytes()) - static_cast<double>(residentBefore);
+			state.ResumeTiming();
+		}
+		state.counters["ResidentGrowth"] = benchmark::Counter{ residentGrowth, benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024 };
+	}
+
+	void CleanAllocator_Sparse_Memset(benchmark::State& state) { allocateSparse<PlainAllocator>(state); }
+	void CleanAllocator_Sparse_Allocator(benchmark::State& state) { allocateSparse<primal::Allocator>(state); }
+	void CleanAllocator_Sparse_LargePageAllocator(benchmark::State& state) { allocateSparse<primal::LargePageAllocator<>>(state); }
+}
+
+BENCHMARK(CleanAllocator_Sparse_Memset)->RangeMultiplier(4)->Range(1 << 20, 1 << 26);
+BENCHMARK(CleanAllocator_Sparse_Allocator)->RangeMultiplier(4)->Range(1 << 20, 1 << 26);
+BENCHMARK(CleanAllocator_Sparse_LargePageAllocator)->RangeMultiplier(4)->Range(1 << 20, 1 << 26);
+
+namespace
+{
+	// Grows a buffer from 4 KiB by doubling its capacity and filling the new half.
+	template <typename A>
+	void growGeometrically(benchmark::State& state)
+	{
+		const auto maxSize = static_cast<size_t>(state.range(0));
+		for (auto _ : state)
+		{
+			primal::Buffer<std::byte, A> buffer;
+			size_t size = 0;
+			for (auto capacity = size_t{ 4096 }; capacity <= maxSize; capacity *= 2)
+			{
+				buffer.reserve(capacity);
+				std::memset(buffer.data() + size, 1, capacity - size);
+				size = capacity;
+			}
+			benchmark::DoNotOptimize(buffer.data());
+		}
+	}
+
+	void Buffer_Growth_Memcpy(benchmark::State& state) { growGeometrically<PlainAllocator>(state); }
+	void Buffer_Growth_Allocator(benchmark::State& state) { growGeometrically<primal::Allocator>(state); }
+	void Buffer_Growth_LargePageAllocator(benchmark::State& state) { growGeometrically<primal::LargePageAllocator<>>(state); }
+}
+
+BENCHMARK(Buffer_Growth_Memcpy)->RangeMultiplier(16)->Range(1 << 20, 1 << 28)->Unit(benchmark::kMillisecond);
+BENCHMARK(Buffer_Growth_Allocator)->RangeMultiplier(16)->Range(1 << 20, 1 << 28)->Unit(benchmark::kMillisecond);
+BENCHMARK(Buffer_Growth_LargePageAllocator)->RangeMultiplier(16)->Range(1 << 20, 1 << 28)->Unit(benchmark::kMillisecond);
@@ -4,6 +4,7 @@
 
 #include <primal/buffer.hpp>
 #include <primal/dsp.hpp>
+#include <primal/large_page_allocator.hpp>
 
 #include <algorithm>
 #include <numeric>
@@ -124,3 +125,45 @@ BENCHMARK(duplicate1D_i16_Opt)->Arg(primal::kDspAlignment)->Arg(2 * primal::kDsp
 BENCHMARK(duplicate1D_i16_Ref)->Arg(primal::kDspAlignment)->Arg(2 * primal::kDspAlignment)->RangeMultiplier(4)->Range(1 << 10, 1 << 20);
 BENCHMARK(duplicate1D_i32_Opt)->Arg(primal::kDspAlignment)->Arg(2 * primal::kDspAlignment)->RangeMultiplier(4)->Range(1 << 10, 1 << 20);
 BENCHMARK(duplicate1D_i32_Ref)->Arg(primal::kDspAlignment)->Arg(2 * primal::kDspAlignment)->RangeMultiplier(4)->Range(1 << 10, 1 << 20);
+
+namespace
+{
+	constexpr size_t kLargeBufferSize = size_t{ 64 } << 20;
+
+	template <typename T, typename A, auto function, size_t kChannelFactor>
+	void benchmark_addSamplesLarge(benchmark::State& state)
+	{
+		primal::Buffer<float, A> dst{ kLargeBufferSize / sizeof(float) };
+		std::iota(dst.data(), dst.data() + dst.capacity(), 0.f);
+		primal::Buffer<T, A> src{ dst.capacity() / kChannelFactor };
+		std::iota(src.data(), src.data() + src.capacity(), T{});
+		for (auto _ : state)
+			function(dst.data(), src.data(), src.capacity());
+	}
+
+	using HeapAllocator = primal::AlignedAllocator<primal::kDspAlignment>;
+	using LargePageAllocator = primal::LargePageAllocator<>;
+
+	constexpr auto addSamples1D_f32 = static_cast<void (*)(float*, const float*, size_t)>(primal::addSamples1D);
+	constexpr auto addSamples1D_i16 = static_cast<void (*)(float*, const int16_t*, size_t)>(primal::addSamples1D);
+	constexpr auto addSamples2x1D_f32 = static_cast<void (*)(float*, const float*, size_t)>(primal::addSamples2x1D);
+	constexpr auto addSamples2x1D_i16 = static_cast<void (*)(float*, const int16_t*, size_t)>(primal::addSamples2x1D);
+
+	void addSamples1D_f32_64M_Heap(benchmark::State& state) { benchmark_addSamplesLarge<float, HeapAllocator, addSamples1D_f32, 1>(state); }
+	void addSamples1D_f32_64M_LargePage(benchmark::State& state) { benchmark_addSamplesLarge<float, LargePageAllocator, addSamples1D_f32, 1>(state); }
+	void addSamples1D_i16_64M_Heap(benchmark::State& state) { benchmark_addSamplesLarge<int16_t, HeapAllocator, addSamples1D_i16, 1>(state); }
+	void addSamples1D_i16_64M_LargePage(benchmark::State& state) { benchmark_addSamplesLarge<int16_t, LargePageAllocator, addSamples1D_i16, 1>(state); }
+	void addSamples2x1D_f32_64M_Heap(benchmark::State& state) { benchmark_addSamplesLarge<float, HeapAllocator, addSamples2x1D_f32, 2>(state); }
+	void addSamples2x1D_f32_64M_LargePage(benchmark::State& state) { benchmark_addSamplesLarge<float, LargePageAllocator, addSamples2x1D_f32, 2>(state); }
+	void addSamples2x1D_i16_64M_Heap(benchmark::State& state) { benchmark_addSamplesLarge<int16_t, HeapAllocator, addSamples2x1D_i16, 2>(state); }
+	void addSamples2x1D_i16_64M_LargePage(benchmark::State& state) { benchmark_addSamplesLarge<int16_t, LargePageAllocator, addSamples2x1D_i16, 2>(state); }
+}
+
+BENCHMARK(addSamples1D_f32_64M_Heap);
+BENCHMARK(addSamples1D_f32_64M_LargePage);
+BENCHMARK(addSamples1D_i16_64M_Heap);
+BENCHMARK(addSamples1D_i16_64M_LargePage);
+BENCHMARK(addSamples2x1D_f32_64M_Heap);
+BENCHMARK(addSamples2x1D_f32_64M_LargePage);
+BENCHMARK(addSamples2x1D_i16_64M_Heap);
+BENCHMARK(addSamples2x1D_i16_64M_LargePage);
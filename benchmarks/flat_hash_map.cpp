@@ -0,0 +1,87 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/flat_hash_map.hpp>
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	std::vector<uint64_t> makeKeys(size_t count, uint64_t seed)
+	{
+		std::mt19937_64 random{ seed };
+		std::vector<uint64_t> keys(count);
+		for (auto& key : keys)
+			key = random();
+		return keys;
+	}
+
+	template <typename Map>
+	auto* findValue(Map& map, uint64_t key)
+	{
+		if constexpr (requires { map.find(key)->second; })
+		{
+			const auto i = map.find(key);
+			return i != map.end() ? &i->second : nullptr;
+		}
+		else
+			return map.find(key);
+	}
+
+	// Looks up existing keys and the same number of missing keys.
+	template <typename Map>
+	void benchmark_Lookup(benchmark::State& state)
+	{
+		const auto count = static_cast<size_t>(state.range(0));
+		const auto keys = makeKeys(count, 1);
+		const auto missingKeys = makeKeys(count, 2);
+		Map map;
+		for (const auto key : keys)
+			map.try_emplace(key, key);
+		for (auto _ : state)
+			for (size_t i = 0; i < count; ++i)
+			{
+				benchmark::DoNotOptimize(findValue(map, keys[i]));
+				benchmark::DoNotOptimize(findValue(map, missingKeys[i]));
+			}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+	}
+
+	// Fills an empty map, then erases every other key and reinserts it.
+	template <typename Map>
+	void benchmark_Insert(benchmark::State& state)
+	{
+		const auto count = static_cast<size_t>(state.range(0));
+		const auto keys = makeKeys(count, 1);
+		for (auto _ : state)
+		{
+			Map map;
+			for (const auto key : keys)
+				map.try_emplace(key, key);
+			for (size_t i = 0; i < count; i += 2)
+				map.erase(keys[i]);
+			for (size_t i = 0; i < count; i += 2)
+				map.try_emplace(keys[i], keys[i]);
+			benchmark::DoNotOptimize(map);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+	}
+
+	using FlatHashMap = primal::FlatHashMap<uint64_t, uint64_t>;
+	using UnorderedMap = std::unordered_map<uint64_t, uint64_t>;
+
+	void FlatHashMap_Insert(benchmark::State& state) { benchmark_Insert<FlatHashMap>(state); }
+	void FlatHashMap_Lookup(benchmark::State& state) { benchmark_Lookup<FlatHashMap>(state); }
+	void UnorderedMap_Insert(benchmark::State& state) { benchmark_Insert<UnorderedMap>(state); }
+	void UnorderedMap_Lookup(benchmark::State& state) { benchmark_Lookup<UnorderedMap>(state); }
+}
+
+BENCHMARK(FlatHashMap_Insert)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(FlatHashMap_Lookup)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(UnorderedMap_Insert)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(UnorderedMap_Lookup)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,79 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/flat_map.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	constexpr size_t kQueryCount = 1 << 12;
+
+	// Sorted keys with gaps, so about a half of the queries miss.
+	std::vector<uint32_t> makeKeys(size_t count)
+	{
+		std::vector<uint32_t> keys(count);
+		for (size_t i = 0; i < count; ++i)
+			keys[i] = static_cast<uint32_t>(i * 2);
+		return keys;
+	}
+
+	std::vector<uint32_t> makeQueries(size_t count)
+	{
+		std::mt19937 random{ 1 };
+		std::uniform_int_distribution<uint32_t> distribution{ 0, static_cast<uint32_t>(count * 2) };
+		std::vector<uint32_t> queries(kQueryCount);
+		for (auto& query : queries)
+			query = distribution(random);
+		return queries;
+	}
+
+	void LowerBound(benchmark::State& state)
+	{
+		const auto count = static_cast<size_t>(state.range(0));
+		const auto keys = makeKeys(count);
+		const auto queries = makeQueries(count);
+		for (auto _ : state)
+			for (const auto query : queries)
+			{
+				const auto i = std::lower_bound(keys.begin(), keys.end(), query);
+				benchmark::DoNotOptimize(i != keys.end() && *i == query);
+			}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kQueryCount));
+	}
+
+	void FlatSet_Contains(benchmark::State& state)
+	{
+		const auto count = static_cast<size_t>(state.range(0));
+		const primal::FlatSet<uint32_t> set{ makeKeys(count) };
+		const auto queries = makeQueries(count);
+		for (auto _ : state)
+			for (const auto query : queries)
+				benchmark::DoNotOptimize(set.contains(query));
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kQueryCount));
+	}
+
+	void FlatSet_ContainsBatch(benchmark::State& state)
+	{
+		const auto count = static_cast<size_t>(state.range(0));
+		const primal::FlatSet<uint32_t> set{ makeKeys(count) };
+		const auto queries = makeQueries(count);
+		const auto results = std::make_unique<bool[]>(kQueryCount);
+		for (auto _ : state)
+		{
+			set.contains(queries, { results.get(), kQueryCount });
+			benchmark::DoNotOptimize(results.get());
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kQueryCount));
+	}
+}
+
+BENCHMARK(LowerBound)->Arg(1'000)->Arg(1'000'000)->Arg(100'000'000);
+BENCHMARK(FlatSet_Contains)->Arg(1'000)->Arg(1'000'000)->Arg(100'000'000);
+BENCHMARK(FlatSet_ContainsBatch)->Arg(1'000)->Arg(1'000'000)->Arg(100'000'000);
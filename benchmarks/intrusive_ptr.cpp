@@ -0,0 +1,78 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/intrusive_ptr.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	constexpr size_t kObjectCount = 1024;
+
+	template <typename Policy>
+	struct Object : primal::RefCounted<Policy>
+	{
+		int _value = 0;
+	};
+
+	// Copies every pointer several times and releases the copies.
+	template <typename Ptr, typename Make>
+	void benchmark_CopyRelease(benchmark::State& state, Make&& make)
+	{
+		std::vector<Ptr> objects;
+		objects.reserve(kObjectCount);
+		for (size_t i = 0; i < kObjectCount; ++i)
+			objects.emplace_back(make());
+		std::vector<Ptr> copies;
+		copies.reserve(kObjectCount * 4);
+		for (auto _ : state)
+		{
+			for (int i = 0; i < 4; ++i)
+				for (const auto& object : objects)
+					copies.emplace_back(object);
+			benchmark::DoNotOptimize(copies.data());
+			copies.clear();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kObjectCount * 4));
+	}
+
+	// Creates and destroys objects.
+	template <typename Ptr, typename Make>
+	void benchmark_CreateRelease(benchmark::State& state, Make&& make)
+	{
+		std::vector<Ptr> objects;
+		objects.reserve(kObjectCount);
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < kObjectCount; ++i)
+				objects.emplace_back(make());
+			benchmark::DoNotOptimize(objects.data());
+			objects.clear();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kObjectCount));
+	}
+
+	using AtomicObject = Object<primal::AtomicRefCount>;
+	using LocalObject = Object<primal::LocalRefCount>;
+	using AtomicPtr = primal::IntrusivePtr<AtomicObject>;
+	using LocalPtr = primal::IntrusivePtr<LocalObject, primal::LocalRefCount>;
+
+	void IntrusivePtr_Atomic_CopyRelease(benchmark::State& state) { benchmark_CopyRelease<AtomicPtr>(state, [] { return AtomicPtr{ new AtomicObject }; }); }
+	void IntrusivePtr_Atomic_CreateRelease(benchmark::State& state) { benchmark_CreateRelease<AtomicPtr>(state, [] { return AtomicPtr{ new AtomicObject }; }); }
+	void IntrusivePtr_Local_CopyRelease(benchmark::State& state) { benchmark_CopyRelease<LocalPtr>(state, [] { return LocalPtr{ new LocalObject }; }); }
+	void IntrusivePtr_Local_CreateRelease(benchmark::State& state) { benchmark_CreateRelease<LocalPtr>(state, [] { return LocalPtr{ new LocalObject }; }); }
+	// Note that libstdc++ uses non-atomic counters in programs which don't link libpthread, which is never the case since glibc 2.34.
+	void SharedPtr_CopyRelease(benchmark::State& state) { benchmark_CopyRelease<std::shared_ptr<int>>(state, [] { return std::make_shared<int>(); }); }
+	void SharedPtr_CreateRelease(benchmark::State& state) { benchmark_CreateRelease<std::shared_ptr<int>>(state, [] { return std::make_shared<int>(); }); }
+}
+
+BENCHMARK(IntrusivePtr_Atomic_CopyRelease);
+BENCHMARK(IntrusivePtr_Atomic_CreateRelease);
+BENCHMARK(IntrusivePtr_Local_CopyRelease);
+BENCHMARK(IntrusivePtr_Local_CreateRelease);
+BENCHMARK(SharedPtr_CopyRelease);
+BENCHMARK(SharedPtr_CreateRelease);
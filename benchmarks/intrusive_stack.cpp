@@ -0,0 +1,70 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/intrusive_stack.hpp>
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	struct Item : primal::IntrusiveNode
+	{
+	};
+
+	constexpr size_t kItemCount = 64;
+
+	// Every thread repeatedly takes an item from the shared free list and returns it back.
+	void IntrusiveStack_PopPush(benchmark::State& state)
+	{
+		static std::array<Item, kItemCount> items;
+		static primal::IntrusiveStack<Item> stack;
+		if (!state.thread_index())
+			for (auto& item : items)
+				stack.push(&item);
+		for (auto _ : state)
+			if (const auto item = stack.pop())
+				stack.push(item);
+		if (!state.thread_index())
+			while (stack.pop())
+				;
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	void MutexStack_PopPush(benchmark::State& state)
+	{
+		static std::array<Item, kItemCount> items;
+		static std::mutex mutex;
+		static std::vector<Item*> stack;
+		if (!state.thread_index())
+			for (auto& item : items)
+				stack.emplace_back(&item);
+		for (auto _ : state)
+		{
+			Item* item = nullptr;
+			{
+				std::lock_guard lock{ mutex };
+				if (!stack.empty())
+				{
+					item = stack.back();
+					stack.pop_back();
+				}
+			}
+			if (item)
+			{
+				std::lock_guard lock{ mutex };
+				stack.emplace_back(item);
+			}
+		}
+		if (!state.thread_index())
+			stack.clear();
+		state.SetItemsProcessed(state.iterations());
+	}
+}
+
+BENCHMARK(IntrusiveStack_PopPush)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(MutexStack_PopPush)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,58 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/buffer.hpp>
+#include <primal/dsp.hpp>
+#include <primal/mirrored_ring_buffer.hpp>
+
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	// Mixes windows of state.range(0) samples from a 64 KiB ring, so that some windows wrap around.
+	constexpr size_t kRingSize = 1 << 16;
+	constexpr size_t kRingSamples = kRingSize / sizeof(int16_t);
+
+	void MirroredRingBuffer_Mix(benchmark::State& state)
+	{
+		const auto window = static_cast<size_t>(state.range(0));
+		primal::MirroredRingBuffer ring{ kRingSize };
+		std::fill_n(reinterpret_cast<int16_t*>(ring.data()), kRingSamples, int16_t{ 1 });
+		primal::Buffer<float, primal::AlignedAllocator<primal::kDspAlignment>> mix{ window };
+		std::fill_n(mix.data(), window, 0.f);
+		size_t offset = 0;
+		for (auto _ : state)
+		{
+			primal::addSamples1D(mix.data(), reinterpret_cast<const int16_t*>(ring.data()) + offset, window);
+			offset = (offset + window) % kRingSamples;
+		}
+		benchmark::DoNotOptimize(mix.data());
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int16_t)));
+	}
+
+	void SplitRingBuffer_Mix(benchmark::State& state)
+	{
+		const auto window = static_cast<size_t>(state.range(0));
+		primal::Buffer<int16_t, primal::AlignedAllocator<primal::kDspAlignment>> ring{ kRingSamples };
+		std::fill_n(ring.data(), kRingSamples, int16_t{ 1 });
+		primal::Buffer<float, primal::AlignedAllocator<primal::kDspAlignment>> mix{ window };
+		std::fill_n(mix.data(), window, 0.f);
+		size_t offset = 0;
+		for (auto _ : state)
+		{
+			const auto first = std::min(window, kRingSamples - offset);
+			primal::addSamples1D(mix.data(), ring.data() + offset, first);
+			if (first < window)
+				primal::addSamples1D(mix.data() + first, ring.data(), window - first);
+			offset = (offset + window) % kRingSamples;
+		}
+		benchmark::DoNotOptimize(mix.data());
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int16_t)));
+	}
+}
+
+BENCHMARK(MirroredRingBuffer_Mix)->Arg(24)->Arg(120)->Arg(1000)->Arg(4088);
+BENCHMARK(SplitRingBuffer_Mix)->Arg(24)->Arg(120)->Arg(1000)->Arg(4088);
@@ -0,0 +1,67 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/mpmc_queue.hpp>
+
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	class MutexQueue
+	{
+	public:
+		uint64_t pop()
+		{
+			for (;;)
+			{
+				{
+					std::lock_guard lock{ _mutex };
+					if (!_items.empty())
+					{
+						const auto value = _items.front();
+						_items.pop_front();
+						return value;
+					}
+				}
+				std::this_thread::yield();
+			}
+		}
+
+		void push(uint64_t value)
+		{
+			std::lock_guard lock{ _mutex };
+			_items.emplace_back(value);
+		}
+
+	private:
+		std::mutex _mutex;
+		std::deque<uint64_t> _items;
+	};
+
+	// Every thread pushes an element and then pops an element (not necessarily the same one),
+	// so the queue never contains more elements than there are threads.
+	template <typename Queue>
+	void benchmark_PushPop(benchmark::State& state)
+	{
+		static Queue queue;
+		uint64_t value = static_cast<uint64_t>(state.thread_index());
+		for (auto _ : state)
+		{
+			queue.push(value);
+			value = queue.pop();
+			benchmark::DoNotOptimize(value);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	void MpmcQueue_PushPop(benchmark::State& state) { benchmark_PushPop<primal::MpmcQueue<uint64_t, 1024>>(state); }
+	void MutexQueue_PushPop(benchmark::State& state) { benchmark_PushPop<MutexQueue>(state); }
+}
+
+BENCHMARK(MpmcQueue_PushPop)->Threads(1)->Threads(4)->Threads(16)->Threads(64)->UseRealTime();
+BENCHMARK(MutexQueue_PushPop)->Threads(1)->Threads(4)->Threads(16)->Threads(64)->UseRealTime();
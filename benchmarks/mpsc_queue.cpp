@@ -0,0 +1,100 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/intrusive_stack.hpp>
+#include <primal/mpsc_queue.hpp>
+
+#include <array>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	constexpr size_t kMaxProducers = 8;
+	constexpr size_t kItemsPerProducer = 256;
+	constexpr size_t kBatchSize = 64;
+
+	struct Item : primal::IntrusiveNode
+	{
+		size_t _producer = 0;
+	};
+
+	// The first thread consumes items and returns them to the free lists of their producers,
+	// and each of the other threads produces kBatchSize items per iteration.
+	template <typename Queue>
+	void benchmark_Mpsc(benchmark::State& state)
+	{
+		static std::array<std::array<Item, kItemsPerProducer>, kMaxProducers> items;
+		static std::array<primal::IntrusiveStack<Item>, kMaxProducers> freeLists;
+		static Queue queue;
+		const auto thread = static_cast<size_t>(state.thread_index());
+		if (thread)
+		{
+			const auto producer = thread - 1;
+			for (auto& item : items[producer])
+			{
+				item._producer = producer;
+				freeLists[producer].push(&item);
+			}
+			for (auto _ : state)
+				for (size_t i = 0; i < kBatchSize;)
+					if (const auto item = freeLists[producer].pop())
+					{
+						queue.push(item);
+						++i;
+					}
+					else
+						std::this_thread::yield();
+			while (freeLists[producer].pop())
+				;
+		}
+		else
+		{
+			const auto batchSize = static_cast<size_t>(state.threads() - 1) * kBatchSize;
+			for (auto _ : state)
+				for (size_t i = 0; i < batchSize;)
+					if (const auto item = queue.pop())
+					{
+						freeLists[item->_producer].push(item);
+						++i;
+					}
+					else
+						std::this_thread::yield();
+			state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batchSize));
+		}
+	}
+
+	class MutexQueue
+	{
+	public:
+		Item* pop()
+		{
+			std::lock_guard lock{ _mutex };
+			if (_items.empty())
+				return nullptr;
+			const auto item = _items.front();
+			_items.pop_front();
+			return item;
+		}
+
+		void push(Item* item)
+		{
+			std::lock_guard lock{ _mutex };
+			_items.emplace_back(item);
+		}
+
+	private:
+		std::mutex _mutex;
+		std::deque<Item*> _items;
+	};
+
+	void MpscQueue_Transfer(benchmark::State& state) { benchmark_Mpsc<primal::MpscQueue<Item>>(state); }
+	void MutexQueue_Transfer(benchmark::State& state) { benchmark_Mpsc<MutexQueue>(state); }
+}
+
+BENCHMARK(MpscQueue_Transfer)->DenseThreadRange(2, kMaxProducers + 1, 3)->UseRealTime();
+BENCHMARK(MutexQueue_Transfer)->DenseThreadRange(2, kMaxProducers + 1, 3)->UseRealTime();
@@ -0,0 +1,68 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/rigid_vector.hpp>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	struct Record
+	{
+		uint32_t id;
+		uint32_t flags;
+		float x;
+		float y;
+	};
+
+	std::vector<Record> makeRecords(benchmark::State& state)
+	{
+		std::vector<Record> records(static_cast<size_t>(state.range(0)));
+		for (size_t i = 0; i < records.size(); ++i)
+			records[i] = { static_cast<uint32_t>(i), 0, static_cast<float>(i), 0.f };
+		return records;
+	}
+
+	void RigidVector_Append(benchmark::State& state)
+	{
+		const auto records = makeRecords(state);
+		for (auto _ : state)
+		{
+			primal::RigidVector<Record> vector;
+			vector.reserve(records.size());
+			vector.append(records.data(), records.size());
+			benchmark::DoNotOptimize(vector.data());
+		}
+	}
+
+	void RigidVector_EmplaceBack(benchmark::State& state)
+	{
+		const auto records = makeRecords(state);
+		for (auto _ : state)
+		{
+			primal::RigidVector<Record> vector;
+			vector.reserve(records.size());
+			for (const auto& record : records)
+				vector.emplace_back(record);
+			benchmark::DoNotOptimize(vector.data());
+		}
+	}
+
+	void RigidVector_EmplaceN(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			primal::RigidVector<Record> vector;
+			vector.reserve(static_cast<size_t>(state.range(0)));
+			vector.emplace_n(static_cast<size_t>(state.range(0)));
+			benchmark::DoNotOptimize(vector.data());
+		}
+	}
+}
+
+BENCHMARK(RigidVector_Append)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(RigidVector_EmplaceBack)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(RigidVector_EmplaceN)->Arg(1 << 10)->Arg(1 << 20);
@@ -0,0 +1,171 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/spsc_ring.hpp>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	constexpr size_t kRingCapacity = 1 << 14;
+
+	// The mutex-protected queue that SpscRing is meant to replace.
+	template <typename T>
+	class MutexRing
+	{
+	public:
+		explicit MutexRing(size_t capacity)
+			: _capacity{ capacity } {}
+
+		size_t write(std::span<const T> data)
+		{
+			std::scoped_lock lock{ _mutex };
+			const auto count = std::min(data.size(), _capacity - _queue.size());
+			_queue.insert(_queue.end(), data.begin(), data.begin() + static_cast<ptrdiff_t>(count));
+			return count;
+		}
+
+		size_t read(std::span<T> data)
+		{
+			std::scoped_lock lock{ _mutex };
+			const auto count = std::min(data.size(), _queue.size());
+			std::copy_n(_queue.begin(), count, data.begin());
+			_queue.erase(_queue.begin(), _queue.begin() + static_cast<ptrdiff_t>(count));
+			return count;
+		}
+
+	private:
+		const size_t _capacity;
+		std::mutex _mutex;
+		std::deque<T> _queue;
+	};
+
+	// The producer writes blocks of samples, the consumer mixes them into its own buffer.
+	template <typename Ring>
+	void benchmark_Throughput(benchmark::State& state)
+	{
+		const auto blockSize = static_cast<size_t>(state.range(0));
+		Ring ring{ kRingCapacity };
+		std::atomic<bool> done{ false };
+		std::thread consumer{ [&] {
+			std::vector<float> mix(blockSize);
+			std::vector<float> block(blockSize);
+			for (;;)
+			{
+				const auto count = ring.read(block);
+				if (count)
+					primal::addSamples1D(mix.data(), block.data(), count);
+				else if (done.load(std::memory_order_acquire))
+					break;
+				else
+					std::this_thread::yield();
+			}
+			benchmark::DoNotOptimize(mix.data());
+		} };
+		const std::vector<float> block(blockSize, 1.f);
+		for (auto _ : state)
+			for (size_t written = 0; written < blockSize;)
+			{
+				const auto count = ring.write({ block.data() + written, blockSize - written });
+				if (!count)
+					std::this_thread::yield();
+				written += count;
+			}
+		done.store(true, std::memory_order_release);
+		consumer.join();
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(float)));
+	}
+
+	// The consumer mixes samples directly from ring memory.
+	void SpscRing_ThroughputZeroCopy(benchmark::State& state)
+	{
+		const auto blockSize = static_cast<size_t>(state.range(0));
+		primal::SpscRing<float> ring{ kRingCapacity };
+		std::atomic<bool> done{ false };
+		std::thread consumer{ [&] {
+			primal::Buffer<float, primal::AlignedAllocator<primal::kDspAlignment>> mix{ blockSize };
+			std::fill_n(mix.data(), blockSize, 0.f);
+			for (;;)
+			{
+				const auto readable = ring.readable();
+				if (!readable.empty())
+				{
+					const auto count = std::min(readable.size(), blockSize);
+					primal::addSamples1D(mix.data(), readable.data(), count);
+					ring.commitRead(count);
+				}
+				else if (done.load(std::memory_order_acquire))
+					break;
+				else
+					std::this_thread::yield();
+			}
+			benchmark::DoNotOptimize(mix.data());
+		} };
+		for (auto _ : state)
+			for (size_t written = 0; written < blockSize;)
+			{
+				const auto writable = ring.writable();
+				const auto count = std::min(writable.size(), blockSize - written);
+				if (!count)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+				std::fill_n(writable.data(), count, 1.f);
+				ring.commitWrite(count);
+				written += count;
+			}
+		done.store(true, std::memory_order_release);
+		consumer.join();
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(float)));
+	}
+
+	// Round trip time of a single element between two threads.
+	template <typename Ring>
+	void benchmark_Latency(benchmark::State& state)
+	{
+		Ring request{ 16 };
+		Ring response{ 16 };
+		std::atomic<bool> done{ false };
+		std::thread echo{ [&] {
+			float value = 0;
+			while (!done.load(std::memory_order_acquire))
+			{
+				if (request.read({ &value, 1 }))
+					while (!response.write({ &value, 1 }))
+						std::this_thread::yield();
+				else
+					std::this_thread::yield();
+			}
+		} };
+		float value = 0;
+		for (auto _ : state)
+		{
+			while (!request.write({ &value, 1 }))
+				std::this_thread::yield();
+			while (!response.read({ &value, 1 }))
+				std::this_thread::yield();
+			value += 1;
+		}
+		done.store(true, std::memory_order_release);
+		echo.join();
+	}
+
+	void MutexRing_Latency(benchmark::State& state) { benchmark_Latency<MutexRing<float>>(state); }
+	void MutexRing_Throughput(benchmark::State& state) { benchmark_Throughput<MutexRing<float>>(state); }
+	void SpscRing_Latency(benchmark::State& state) { benchmark_Latency<primal::SpscRing<float>>(state); }
+	void SpscRing_Throughput(benchmark::State& state) { benchmark_Throughput<primal::SpscRing<float>>(state); }
+}
+
+BENCHMARK(MutexRing_Latency)->UseRealTime();
+BENCHMARK(MutexRing_Throughput)->RangeMultiplier(8)->Range(64, 4096)->UseRealTime();
+BENCHMARK(SpscRing_Latency)->UseRealTime();
+BENCHMARK(SpscRing_Throughput)->RangeMultiplier(8)->Range(64, 4096)->UseRealTime();
+BENCHMARK(SpscRing_ThroughputZeroCopy)->RangeMultiplier(8)->Range(64, 4096)->UseRealTime();
@@ -0,0 +1,69 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/static_hash_map.hpp>
+#include <primal/static_vector.hpp>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	constexpr size_t kMaxEntries = 64;
+
+	std::vector<uint32_t> makeKeys(size_t count)
+	{
+		std::mt19937 random{ 1 };
+		std::vector<uint32_t> keys(count);
+		for (auto& key : keys)
+			key = static_cast<uint32_t>(random());
+		return keys;
+	}
+
+	// Looks up every key (in a shuffled order) and a missing key for each.
+	void StaticHashMap_Lookup(benchmark::State& state)
+	{
+		const auto count = static_cast<size_t>(state.range(0));
+		auto keys = makeKeys(count);
+		primal::StaticHashMap<uint32_t, uint32_t, kMaxEntries> map;
+		for (const auto key : keys)
+			map.try_emplace(key, key);
+		std::shuffle(keys.begin(), keys.end(), std::mt19937{ 2 });
+		for (auto _ : state)
+			for (const auto key : keys)
+			{
+				benchmark::DoNotOptimize(map.find(key));
+				benchmark::DoNotOptimize(map.find(key + 1));
+			}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+	}
+
+	void StaticVector_Lookup(benchmark::State& state)
+	{
+		const auto count = static_cast<size_t>(state.range(0));
+		auto keys = makeKeys(count);
+		primal::StaticVector<std::pair<uint32_t, uint32_t>, kMaxEntries> vector;
+		for (const auto key : keys)
+			vector.emplace_back(key, key);
+		const auto find = [&vector](uint32_t key) {
+			const auto i = std::find_if(vector.begin(), vector.end(), [key](const auto& entry) { return entry.first == key; });
+			return i != vector.end() ? &i->second : nullptr;
+		};
+		std::shuffle(keys.begin(), keys.end(), std::mt19937{ 2 });
+		for (auto _ : state)
+			for (const auto key : keys)
+			{
+				benchmark::DoNotOptimize(find(key));
+				benchmark::DoNotOptimize(find(key + 1));
+			}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+	}
+}
+
+BENCHMARK(StaticHashMap_Lookup)->RangeMultiplier(2)->Range(4, kMaxEntries);
+BENCHMARK(StaticVector_Lookup)->RangeMultiplier(2)->Range(4, kMaxEntries);
@@ -0,0 +1,59 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/buffer.hpp>
+#include <primal/dsp.hpp>
+#include <primal/thread_pool.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	constexpr size_t kSamples = (256 << 20) / sizeof(float);
+	constexpr size_t kGrain = 64 << 10; // Multiple of the SSE block size, so every subrange stays aligned.
+
+	void threadCounts(benchmark::internal::Benchmark* benchmark)
+	{
+		const auto maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		for (unsigned threads = 1; threads < maxThreads; threads *= 2)
+			benchmark->Arg(threads);
+		benchmark->Arg(maxThreads);
+	}
+
+	void ThreadPool_AddSamples1D(benchmark::State& state)
+	{
+		primal::Buffer<int16_t, primal::AlignedAllocator<primal::kDspAlignment>> src{ kSamples };
+		std::iota(src.data(), src.data() + kSamples, int16_t{});
+		primal::Buffer<float, primal::AlignedAllocator<primal::kDspAlignment>> dst{ kSamples };
+		std::fill_n(dst.data(), kSamples, 0.f);
+		primal::ThreadPool pool{ static_cast<size_t>(state.range(0) - 1) }; // The calling thread participates too.
+		for (auto _ : state)
+		{
+			pool.parallel_for(0, kSamples, kGrain, [&dst, &src](size_t first, size_t last) {
+				primal::addSamples1D(dst.data() + first, src.data() + first, last - first);
+			});
+			benchmark::DoNotOptimize(dst.data());
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(kSamples * (sizeof(float) + sizeof(int16_t))));
+	}
+
+	void ThreadPool_EmptyTasks(benchmark::State& state)
+	{
+		primal::ThreadPool pool{ static_cast<size_t>(state.range(0) - 1) };
+		for (auto _ : state)
+		{
+			primal::TaskGroup group{ pool };
+			for (int i = 0; i < 1024; ++i)
+				group.run([] {});
+		}
+		state.SetItemsProcessed(state.iterations() * 1024);
+	}
+}
+
+BENCHMARK(ThreadPool_AddSamples1D)->Apply(threadCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(ThreadPool_EmptyTasks)->Apply(threadCounts)->UseRealTime();
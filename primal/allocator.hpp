@@ -7,6 +7,7 @@
 #include <primal/macros.hpp>
 
 #include <bit>
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <new>
@@ -24,6 +25,23 @@ namespace primal
 			throw std::bad_alloc{};
 		}
 
+		[[nodiscard]] static void* allocateZeroed(size_t size)
+		{
+			if (const auto memory = std::calloc(size, 1); memory)
+				[[likely]]
+				return memory;
+			throw std::bad_alloc{};
+		}
+
+		// Large blocks are grown in place (or remapped without copying) if possible.
+		[[nodiscard]] static void* reallocate(void* memory, size_t size)
+		{
+			if (const auto newMemory = std::realloc(memory, size); newMemory)
+				[[likely]]
+				return newMemory;
+			throw std::bad_alloc{};
+		}
+
 		static void deallocate(void* memory) noexcept
 		{
 			std::free(memory);
@@ -50,6 +68,25 @@ namespace primal
 			throw std::bad_alloc{};
 		}
 
+#ifndef _MSC_VER
+		// Blocks with the default alignment can be managed with calloc() and realloc() since they're freed with free().
+		[[nodiscard]] static void* allocateZeroed(size_t size) requires(kAlignment <= alignof(std::max_align_t))
+		{
+			if (const auto memory = std::calloc(size, 1); memory)
+				[[likely]]
+				return memory;
+			throw std::bad_alloc{};
+		}
+
+		[[nodiscard]] static void* reallocate(void* memory, size_t size) requires(kAlignment <= alignof(std::max_align_t))
+		{
+			if (const auto newMemory = std::realloc(memory, size); newMemory)
+				[[likely]]
+				return newMemory;
+			throw std::bad_alloc{};
+		}
+#endif
+
 		static void deallocate(void* memory) noexcept
 		{
 #ifdef _MSC_VER
@@ -60,12 +97,20 @@ namespace primal
 		}
 	};
 
+	// Allocator which zero-fills allocated blocks.
+	// Large blocks are obtained from A::allocateZeroed() if it is available, which may return
+	// fresh zero pages without touching them, so that the system commits them lazily.
 	template <typename A>
 	class CleanAllocator
 	{
 	public:
+		static constexpr size_t kLazyZeroingThreshold = size_t{ 1 } << 16;
+
 		[[nodiscard]] static void* allocate(size_t size)
 		{
+			if constexpr (requires { A::allocateZeroed(size); })
+				if (size >= kLazyZeroingThreshold)
+					return A::allocateZeroed(size);
 			const auto memory = A::allocate(size);
 			std::memset(memory, 0, size);
 			return memory;
@@ -76,4 +121,36 @@ namespace primal
 			A::deallocate(memory);
 		}
 	};
+
+	// Pointer deleter which returns memory to the allocator.
+	// Allocators with state are stored in the deleter, stateless ones take no space.
+	template <typename A>
+	class AllocatorDeleter : private A
+	{
+	public:
+		constexpr AllocatorDeleter() noexcept = default;
+
+		constexpr explicit AllocatorDeleter(const A& allocator) noexcept
+			: A{ allocator } {}
+
+		[[nodiscard]] constexpr A& allocator() noexcept { return *this; }
+		[[nodiscard]] constexpr const A& allocator() const noexcept { return *this; }
+
+		template <typename T>
+		void free(T* pointer) noexcept
+		{
+			if (pointer)
+				A::deallocate(pointer);
+		}
+	};
+
+	// Minimum alignment of memory blocks returned by the allocator.
+	template <typename A>
+	constexpr size_t kAllocatorAlignment = alignof(std::max_align_t);
+
+	template <size_t kAlignment>
+	constexpr size_t kAllocatorAlignment<AlignedAllocator<kAlignment>> = kAlignment > alignof(std::max_align_t) ? kAlignment : alignof(std::max_align_t);
+
+	template <typename A>
+	constexpr size_t kAllocatorAlignment<CleanAllocator<A>> = kAllocatorAlignment<A>;
 }
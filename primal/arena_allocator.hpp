@@ -0,0 +1,178 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/allocator.hpp>
+#include <primal/macros.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace primal
+{
+	// Thread-local monotonic memory arena.
+	// Memory is bump-allocated from chunks and is reclaimed only when the enclosing ArenaScope ends,
+	// or when the thread exits if there is no such scope. Regular-sized chunks are kept for reuse.
+	class Arena
+	{
+	public:
+		// Size of a regular arena chunk, including the chunk header.
+		// Larger allocations get dedicated chunks which are freed immediately on rewind.
+		static constexpr size_t kChunkSize = size_t{ 1 } << 20;
+
+		// Arena position which can be rewound to.
+		struct Mark
+		{
+			void* _chunk = nullptr;
+			uintptr_t _current = 0;
+		};
+
+		[[nodiscard]] static void* allocate(size_t size, size_t alignment)
+		{
+			auto& state = _state;
+			const auto aligned = (state._current + alignment - 1) & ~(alignment - 1);
+			if (!state._chunk || aligned < state._current || aligned > state._end || size > state._end - aligned)
+				[[unlikely]]
+				return allocateChunk(size, alignment);
+			state._current = aligned + size;
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		[[nodiscard]] static Mark mark() noexcept
+		{
+			return { _state._chunk, _state._current };
+		}
+
+		// Frees everything allocated in the current thread after the mark was taken.
+		static void rewind(const Mark& mark) noexcept
+		{
+			auto& state = _state;
+			while (state._chunk != mark._chunk)
+			{
+				const auto chunk = state._chunk;
+				state._chunk = chunk->_previous;
+				if (chunk->_end - reinterpret_cast<uintptr_t>(chunk) == kChunkSize && !state._destroyed)
+				{
+					chunk->_previous = state._spare;
+					state._spare = chunk;
+				}
+				else
+					Allocator::deallocate(chunk);
+			}
+			state._current = mark._current;
+			state._end = state._chunk ? state._chunk->_end : 0;
+		}
+
+	private:
+		struct Chunk
+		{
+			Chunk* _previous;
+			uintptr_t _end;
+		};
+
+		struct State
+		{
+			Chunk* _chunk = nullptr;
+			uintptr_t _current = 0;
+			uintptr_t _end = 0;
+			Chunk* _spare = nullptr;
+			bool _destroyed = false;
+
+			// Thread-local destructors which run later may still use the arena,
+			// but their chunks are freed only by their ArenaScope and are never kept for reuse.
+			~State() noexcept
+			{
+				freeChunks(std::exchange(_chunk, nullptr));
+				freeChunks(std::exchange(_spare, nullptr));
+				_current = 0;
+				_end = 0;
+				_destroyed = true;
+			}
+		};
+
+		static void* allocateChunk(size_t size, size_t alignment)
+		{
+			auto& state = _state;
+			const auto requiredSize = sizeof(Chunk) + alignment - 1 + size;
+			if (requiredSize < size)
+				throw std::bad_alloc{};
+			Chunk* chunk;
+			if (requiredSize <= kChunkSize && state._spare)
+			{
+				chunk = state._spare;
+				state._spare = chunk->_previous;
+			}
+			else
+			{
+				const auto chunkSize = requiredSize > kChunkSize ? requiredSize : kChunkSize;
+				chunk = static_cast<Chunk*>(Allocator::allocate(chunkSize));
+				chunk->_end = reinterpret_cast<uintptr_t>(chunk) + chunkSize;
+			}
+			chunk->_previous = state._chunk;
+			state._chunk = chunk;
+			const auto aligned = (reinterpret_cast<uintptr_t>(chunk + 1) + alignment - 1) & ~(alignment - 1);
+			state._current = aligned + size;
+			state._end = chunk->_end;
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		static void freeChunks(Chunk* chunk) noexcept
+		{
+			while (chunk)
+				Allocator::deallocate(std::exchange(chunk, chunk->_previous));
+		}
+
+		static thread_local State _state;
+	};
+
+#ifdef __clang__
+#	pragma clang diagnostic push
+#	pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+	inline thread_local Arena::State Arena::_state;
+#ifdef __clang__
+#	pragma clang diagnostic pop
+#endif
+
+	// Allocator which allocates from the thread-local Arena and never deallocates.
+	// The memory is reclaimed at the end of the enclosing ArenaScope, so all users of it
+	// (including destructors of the owning containers) must finish before that.
+	template <size_t kAlignment = alignof(std::max_align_t)>
+	class ArenaAllocator
+	{
+	public:
+		static_assert(std::has_single_bit(kAlignment));
+
+		[[nodiscard]] static void* allocate(size_t size)
+		{
+			return Arena::allocate(size, kAlignment);
+		}
+
+		static void deallocate(void*) noexcept {}
+	};
+
+	template <size_t kAlignment>
+	constexpr size_t kAllocatorAlignment<ArenaAllocator<kAlignment>> = kAlignment;
+
+	// Reclaims all memory allocated from the thread-local Arena during the lifetime of the scope.
+	class ArenaScope
+	{
+	public:
+		ArenaScope() noexcept
+			: _mark{ Arena::mark() } {}
+
+		~ArenaScope() noexcept { Arena::rewind(_mark); }
+
+		ArenaScope(const ArenaScope&) = delete;
+		ArenaScope& operator=(const ArenaScope&) = delete;
+
+	private:
+		const Arena::Mark _mark;
+	};
+}
+
+#define PRIMAL_ARENA_SCOPE() const primal::ArenaScope PRIMAL_JOIN(primalArenaScope, __LINE__)
@@ -24,8 +24,15 @@ namespace primal
 		Buffer(const Buffer&) = delete;
 		Buffer& operator=(Buffer&) = delete;
 
-		explicit Buffer(size_t capacity)
-			: _data{ static_cast<T*>(A::allocate(capacity * sizeof(T))) }, _capacity{ capacity } {}
+		constexpr explicit Buffer(const A& allocator) noexcept
+			: _data{ nullptr, allocator } {}
+
+		explicit Buffer(size_t capacity, const A& allocator = A{})
+			: _data{ nullptr, allocator }
+		{
+			_data.reset(static_cast<T*>(_data.deleter().allocator().allocate(capacity * sizeof(T))));
+			_capacity = capacity;
+		}
 
 		constexpr Buffer(Buffer&& other) noexcept
 			: _data{ std::move(other._data) }, _capacity{ other._capacity } { other._capacity = 0; }
@@ -36,16 +43,28 @@ namespace primal
 			return *this;
 		}
 
+		[[nodiscard]] constexpr const A& allocator() const noexcept { return _data.deleter().allocator(); }
 		[[nodiscard]] constexpr size_t capacity() const noexcept { return _capacity; }
 		[[nodiscard]] constexpr T* data() noexcept { return _data; }
 		[[nodiscard]] constexpr const T* data() const noexcept { return _data; }
 
+		// Uses A::reallocate(memory, size) to preserve the contents if the allocator provides it.
 		void reserve(size_t newCapacity, bool preserveContents = true)
 		{
 			if (newCapacity <= _capacity)
 				return;
-			decltype(_data) newData{ static_cast<T*>(A::allocate(newCapacity * sizeof(T))) };
-			if (preserveContents)
+			auto& allocator = _data.deleter().allocator();
+			if constexpr (requires { allocator.reallocate(_data.get(), newCapacity * sizeof(T)); })
+			{
+				if (preserveContents && _data)
+				{
+					*_data.out() = static_cast<T*>(allocator.reallocate(_data, newCapacity * sizeof(T)));
+					_capacity = newCapacity;
+					return;
+				}
+			}
+			decltype(_data) newData{ static_cast<T*>(allocator.allocate(newCapacity * sizeof(T))), allocator };
+			if (preserveContents && _data)
 				std::memcpy(newData, _data, (newCapacity < _capacity ? newCapacity : _capacity) * sizeof(T));
 			_data = std::move(newData);
 			_capacity = newCapacity;
@@ -59,7 +78,7 @@ namespace primal
 		}
 
 	private:
-		CPtr<T, A::deallocate> _data;
+		Pointer<T, AllocatorDeleter<A>> _data;
 		size_t _capacity = 0;
 	};
 }
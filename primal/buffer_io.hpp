@@ -0,0 +1,171 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/buffer.hpp>
+#include <primal/endian.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+namespace primal
+{
+	// Appends data to a Buffer, growing it geometrically.
+	// Unchecked functions require the space to be reserved beforehand, which allows
+	// a single capacity check for a batch of writes.
+	template <typename A = Allocator>
+	class BufferWriter
+	{
+	public:
+		constexpr explicit BufferWriter(Buffer<std::byte, A>& buffer, size_t offset = 0) noexcept
+			: _buffer{ buffer }, _size{ offset } { assert(offset <= buffer.capacity()); }
+
+		[[nodiscard]] constexpr std::byte* data() noexcept { return _buffer.data(); }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _size; }
+
+		void append(const void* data, size_t size)
+		{
+			reserve(size);
+			appendUnchecked(data, size);
+		}
+
+		void appendUnchecked(const void* data, size_t size) noexcept
+		{
+			assert(size <= _buffer.capacity() - _size);
+			if (!size)
+				return; // The buffer may have no memory at all.
+			std::memcpy(_buffer.data() + _size, data, size);
+			_size += size;
+		}
+
+		template <typename T>
+		void appendBigEndian(T value)
+		{
+			reserve(sizeof value);
+			appendBigEndianUnchecked(value);
+		}
+
+		template <typename T>
+		void appendBigEndianUnchecked(T value) noexcept
+		{
+			const auto converted = bigEndian(value);
+			appendUnchecked(&converted, sizeof converted);
+		}
+
+		template <typename T>
+		void appendLittleEndian(T value)
+		{
+			reserve(sizeof value);
+			appendLittleEndianUnchecked(value);
+		}
+
+		template <typename T>
+		void appendLittleEndianUnchecked(T value) noexcept
+		{
+			const auto converted = littleEndian(value);
+			appendUnchecked(&converted, sizeof converted);
+		}
+
+		// Ensures that the specified number of bytes can be appended without reallocation.
+		void reserve(size_t size)
+		{
+			const auto capacity = _buffer.capacity();
+			if (size <= capacity - _size)
+				[[likely]]
+				return;
+			const auto required = _size + size;
+			if (required < size)
+				throw std::bad_alloc{};
+			auto newCapacity = capacity > kMinCapacity / 2 ? 2 * capacity : kMinCapacity;
+			if (newCapacity < required || newCapacity < capacity)
+				newCapacity = required;
+			_buffer.reserve(newCapacity);
+		}
+
+	private:
+		static constexpr size_t kMinCapacity = 64;
+
+		Buffer<std::byte, A>& _buffer;
+		size_t _size;
+	};
+
+	// Reads data from memory.
+	// Checked functions fail without side effects if there is not enough data,
+	// unchecked functions require the data to be available (see canRead()).
+	class BufferReader
+	{
+	public:
+		constexpr BufferReader(const void* data, size_t size) noexcept
+			: _data{ static_cast<const std::byte*>(data) }, _end{ _data + size } {}
+
+		[[nodiscard]] constexpr bool canRead(size_t size) const noexcept { return size <= remaining(); }
+		[[nodiscard]] constexpr const std::byte* current() const noexcept { return _data; }
+		[[nodiscard]] constexpr size_t remaining() const noexcept { return static_cast<size_t>(_end - _data); }
+
+		[[nodiscard]] bool read(void* data, size_t size) noexcept
+		{
+			if (!canRead(size))
+				return false;
+			readUnchecked(data, size);
+			return true;
+		}
+
+		void readUnchecked(void* data, size_t size) noexcept
+		{
+			assert(canRead(size));
+			if (!size)
+				return; // The reader may have no data at all.
+			std::memcpy(data, _data, size);
+			_data += size;
+		}
+
+		template <typename T>
+		[[nodiscard]] bool readBigEndian(T& value) noexcept
+		{
+			if (!canRead(sizeof value))
+				return false;
+			value = readBigEndianUnchecked<T>();
+			return true;
+		}
+
+		template <typename T>
+		[[nodiscard]] T readBigEndianUnchecked() noexcept
+		{
+			T value;
+			readUnchecked(&value, sizeof value);
+			return bigEndian(value);
+		}
+
+		template <typename T>
+		[[nodiscard]] bool readLittleEndian(T& value) noexcept
+		{
+			if (!canRead(sizeof value))
+				return false;
+			value = readLittleEndianUnchecked<T>();
+			return true;
+		}
+
+		template <typename T>
+		[[nodiscard]] T readLittleEndianUnchecked() noexcept
+		{
+			T value;
+			readUnchecked(&value, sizeof value);
+			return littleEndian(value);
+		}
+
+		[[nodiscard]] bool skip(size_t size) noexcept
+		{
+			if (!canRead(size))
+				return false;
+			_data += size;
+			return true;
+		}
+
+	private:
+		const std::byte* _data;
+		const std::byte* const _end;
+	};
+}
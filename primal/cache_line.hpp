@@ -0,0 +1,14 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+
+namespace primal
+{
+	// Cache line size used to keep data modified by different threads apart.
+	// It is fixed instead of std::hardware_destructive_interference_size, which may vary with compiler flags.
+	constexpr size_t kCacheLineSize = 64;
+}
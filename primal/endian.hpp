@@ -6,11 +6,28 @@
 
 #include <bit>
 #include <cstdint>
+#include <type_traits>
 
 namespace primal
 {
 	[[nodiscard]] constexpr uint16_t swapBytes(uint16_t x) noexcept { return static_cast<uint16_t>(x >> 8 | x << 8); }
 	[[nodiscard]] constexpr uint32_t swapBytes(uint32_t x) noexcept { return x << 24 | (x & 0xff00) << 8 | (x & 0xff0000) >> 8 | x >> 24; }
+	[[nodiscard]] constexpr uint64_t swapBytes(uint64_t x) noexcept { return uint64_t{ swapBytes(static_cast<uint32_t>(x)) } << 32 | swapBytes(static_cast<uint32_t>(x >> 32)); }
+
+	// Reverses the byte order of an arithmetic or enumeration value of any other type.
+	template <typename T>
+	[[nodiscard]] constexpr T swapBytes(T x) noexcept
+	{
+		static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+		static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+		if constexpr (sizeof(T) == 1)
+			return x;
+		else
+		{
+			using U = std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+			return std::bit_cast<T>(swapBytes(std::bit_cast<U>(x)));
+		}
+	}
 
 	template <typename T>
 	[[nodiscard]] constexpr T bigEndian(T x) noexcept
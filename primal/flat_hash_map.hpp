@@ -0,0 +1,357 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/buffer.hpp>
+#include <primal/intrinsics.hpp>
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace primal
+{
+	// Open addressing hash map which stores keys and values inline.
+	// Every slot has a control byte which is either empty, deleted, or contains seven bits of the key hash,
+	// and groups of 16 control bytes are matched at once (with SSE if available).
+	// References to values are invalidated by insertions which grow the table.
+	template <typename K, typename V, typename Hash = std::hash<K>, typename A = Allocator>
+	class FlatHashMap
+	{
+		struct Slot;
+		template <typename S, typename KeyRef, typename ValueRef>
+		class Iterator;
+
+	public:
+		using iterator = Iterator<Slot, const K&, V&>;
+		using const_iterator = Iterator<const Slot, const K&, const V&>;
+
+		static_assert(std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>);
+
+		constexpr FlatHashMap() noexcept = default;
+		FlatHashMap(const FlatHashMap&) = delete;
+		FlatHashMap& operator=(const FlatHashMap&) = delete;
+
+		constexpr explicit FlatHashMap(const A& allocator) noexcept
+			: _buffer{ allocator } {}
+
+		constexpr FlatHashMap(FlatHashMap&& other) noexcept
+			: _buffer{ std::move(other._buffer) }
+			, _capacity{ std::exchange(other._capacity, size_t{}) }
+			, _size{ std::exchange(other._size, size_t{}) }
+			, _growthLeft{ std::exchange(other._growthLeft, size_t{}) }
+		{
+		}
+
+		~FlatHashMap() noexcept
+		{
+			destroySlots();
+		}
+
+		constexpr FlatHashMap& operator=(FlatHashMap&& other) noexcept
+		{
+			swap(*this, other);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr const A& allocator() const noexcept { return _buffer.allocator(); }
+		[[nodiscard]] iterator begin() noexcept { return { control(), slots(), control() + _capacity }; }
+		[[nodiscard]] const_iterator begin() const noexcept { return { control(), slots(), control() + _capacity }; }
+		[[nodiscard]] constexpr size_t capacity() const noexcept { return _capacity; }
+		[[nodiscard]] bool contains(const K& key) const noexcept { return find(key) != nullptr; }
+		[[nodiscard]] constexpr bool empty() const noexcept { return !_size; }
+		[[nodiscard]] iterator end() noexcept { return { control() + _capacity, slots() + _capacity, control() + _capacity }; }
+		[[nodiscard]] const_iterator end() const noexcept { return { control() + _capacity, slots() + _capacity, control() + _capacity }; }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _size; }
+
+		void clear() noexcept
+		{
+			destroySlots();
+			if (_capacity)
+				resetControl(control(), _capacity);
+			_size = 0;
+			_growthLeft = maxSize(_capacity);
+		}
+
+		// Returns true if the key was found and erased.
+		bool erase(const K& key) noexcept
+		{
+			const auto index = findIndex(key, hashOf(key));
+			if (index == _capacity)
+				return false;
+			std::destroy_at(slots() + index);
+			setControl(index, kDeleted);
+			--_size;
+			return true;
+		}
+
+		// Returns a pointer to the value, or nullptr if there is no such key.
+		[[nodiscard]] V* find(const K& key) noexcept
+		{
+			const auto index = findIndex(key, hashOf(key));
+			return index != _capacity ? &slots()[index]._value : nullptr;
+		}
+
+		[[nodiscard]] const V* find(const K& key) const noexcept
+		{
+			const auto index = findIndex(key, hashOf(key));
+			return index != _capacity ? &slots()[index]._value : nullptr;
+		}
+
+		// Makes room for the specified number of elements.
+		void reserve(size_t size)
+		{
+			if (size > _size + _growthLeft)
+				rehash(capacityFor(size));
+		}
+
+		// Inserts a value constructed from the arguments if there is no such key.
+		// Returns a pointer to the value with the key and whether it was inserted.
+		template <typename Key, typename... Args>
+		std::pair<V*, bool> try_emplace(Key&& key, Args&&... args) requires std::is_same_v<std::remove_cvref_t<Key>, K>
+		{
+			const auto hash = hashOf(key);
+			if (const auto index = findIndex(key, hash); index != _capacity)
+				return { &slots()[index]._value, false };
+			if (!_growthLeft)
+				[[unlikely]]
+				return { emplaceGrow(hash, std::forward<Key>(key), std::forward<Args>(args)...), true };
+			const auto index = findFreeIndex(hash);
+			const auto slot = new (slots() + index) Slot{ std::forward<Key>(key), V{ std::forward<Args>(args)... } };
+			occupy(index, hash);
+			return { &slot->_value, true };
+		}
+
+		V& operator[](const K& key) requires std::is_default_constructible_v<V>
+		{
+			return *try_emplace(key).first;
+		}
+
+		friend constexpr void swap(FlatHashMap& first, FlatHashMap& second) noexcept
+		{
+			using std::swap;
+			swap(first._buffer, second._buffer);
+			swap(first._capacity, second._capacity);
+			swap(first._size, second._size);
+			swap(first._growthLeft, second._growthLeft);
+		}
+
+	private:
+		static constexpr size_t kGroupSize = 16;
+		static constexpr int8_t kEmpty = -128;
+		static constexpr int8_t kDeleted = -2;
+
+		struct Slot
+		{
+			K _key;
+			V _value;
+		};
+
+		static_assert(alignof(Slot) <= kAllocatorAlignment<A>);
+
+		template <typename S, typename KeyRef, typename ValueRef>
+		class Iterator
+		{
+		public:
+			using difference_type = ptrdiff_t;
+			using value_type = std::pair<KeyRef, ValueRef>;
+			using iterator_category = std::forward_iterator_tag;
+
+			constexpr Iterator() noexcept = default;
+
+			[[nodiscard]] constexpr std::pair<KeyRef, ValueRef> operator*() const noexcept { return { _slot->_key, _slot->_value }; }
+			[[nodiscard]] constexpr bool operator==(const Iterator& other) const noexcept { return _slot == other._slot; }
+
+			constexpr Iterator& operator++() noexcept
+			{
+				++_control;
+				++_slot;
+				skipFree();
+				return *this;
+			}
+
+			constexpr Iterator operator++(int) noexcept
+			{
+				auto result = *this;
+				++*this;
+				return result;
+			}
+
+		private:
+			const int8_t* _control = nullptr;
+			S* _slot = nullptr;
+			const int8_t* _end = nullptr;
+
+			constexpr Iterator(const int8_t* control, S* slot, const int8_t* end) noexcept
+				: _control{ control }, _slot{ slot }, _end{ end } { skipFree(); }
+
+			constexpr void skipFree() noexcept
+			{
+				for (; _control != _end && *_control < 0; ++_control)
+					++_slot;
+			}
+
+			friend FlatHashMap;
+		};
+
+		// Bit masks of matching control bytes in a group.
+		static uint32_t matchByte(const int8_t* group, int8_t value) noexcept
+		{
+#if PRIMAL_INTRINSICS_SSE
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group)), _mm_set1_epi8(value))));
+#else
+			uint32_t mask = 0;
+			for (size_t i = 0; i < kGroupSize; ++i)
+				mask |= uint32_t{ group[i] == value } << i;
+			return mask;
+#endif
+		}
+
+		// Empty and deleted control bytes are the only negative ones.
+		static uint32_t matchFree(const int8_t* group) noexcept
+		{
+#if PRIMAL_INTRINSICS_SSE
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+			uint32_t mask = 0;
+			for (size_t i = 0; i < kGroupSize; ++i)
+				mask |= uint32_t{ group[i] < 0 } << i;
+			return mask;
+#endif
+		}
+
+		// The table is at most 7/8 full.
+		static constexpr size_t maxSize(size_t capacity) noexcept { return capacity - capacity / 8; }
+
+		static size_t capacityFor(size_t size)
+		{
+			if (size > SIZE_MAX / 16)
+				throw std::bad_alloc{};
+			return std::bit_ceil(size + size / 7 + 1 > kGroupSize ? size + size / 7 + 1 : kGroupSize);
+		}
+
+		// The hash is mixed so that both the probe start and the stored bits depend on all input bits.
+		static uint64_t hashOf(const K& key) noexcept
+		{
+			auto hash = static_cast<uint64_t>(Hash{}(key)) * 0x9e3779b97f4a7c15;
+			return hash ^ (hash >> 32);
+		}
+
+		// The last kGroupSize control bytes mirror the first ones, so any group can be loaded without wrapping.
+		static void resetControl(int8_t* control, size_t capacity) noexcept
+		{
+			std::memset(control, kEmpty, capacity + kGroupSize);
+		}
+
+		int8_t* control() noexcept { return reinterpret_cast<int8_t*>(_buffer.data() + _capacity * sizeof(Slot)); }
+		const int8_t* control() const noexcept { return reinterpret_cast<const int8_t*>(_buffer.data() + _capacity * sizeof(Slot)); }
+		Slot* slots() noexcept { return reinterpret_cast<Slot*>(_buffer.data()); }
+		const Slot* slots() const noexcept { return reinterpret_cast<const Slot*>(_buffer.data()); }
+
+		void destroySlots() noexcept
+		{
+			if constexpr (!std::is_trivially_destructible_v<Slot>)
+				for (size_t i = 0; i < _capacity; ++i)
+					if (control()[i] >= 0)
+						std::destroy_at(slots() + i);
+		}
+
+		// Returns the capacity if there is no such key.
+		// The new slot is constructed before rehashing because the arguments may refer to existing elements.
+		template <typename Key, typename... Args>
+		V* emplaceGrow(uint64_t hash, Key&& key, Args&&... args)
+		{
+			Slot slot{ std::forward<Key>(key), V{ std::forward<Args>(args)... } };
+			rehash(capacityFor(_size + 1));
+			const auto index = findFreeIndex(hash);
+			const auto result = new (slots() + index) Slot{ std::move(slot) };
+			occupy(index, hash);
+			return &result->_value;
+		}
+
+		size_t findIndex(const K& key, uint64_t hash) const noexcept
+		{
+			if (!_size)
+				return _capacity;
+			const auto mask = _capacity - 1;
+			const auto h2 = static_cast<int8_t>(hash & 0x7f);
+			for (size_t position = static_cast<size_t>(hash >> 7) & mask, step = kGroupSize;; position = (position + step) & mask, step += kGroupSize)
+			{
+				const auto group = control() + position;
+				for (auto matches = matchByte(group, h2); matches; matches &= matches - 1)
+				{
+					const auto index = (position + static_cast<size_t>(std::countr_zero(matches))) & mask;
+					if (slots()[index]._key == key)
+						[[likely]]
+						return index;
+				}
+				if (matchByte(group, kEmpty))
+					[[likely]]
+					return _capacity;
+			}
+		}
+
+		// Returns the first empty or deleted slot on the probe sequence.
+		size_t findFreeIndex(uint64_t hash) const noexcept
+		{
+			const auto mask = _capacity - 1;
+			for (size_t position = static_cast<size_t>(hash >> 7) & mask, step = kGroupSize;; position = (position + step) & mask, step += kGroupSize)
+				if (const auto matches = matchFree(control() + position))
+					return (position + static_cast<size_t>(std::countr_zero(matches))) & mask;
+		}
+
+		void occupy(size_t index, uint64_t hash) noexcept
+		{
+			if (control()[index] == kEmpty)
+				--_growthLeft;
+			setControl(index, static_cast<int8_t>(hash & 0x7f));
+			++_size;
+		}
+
+		void rehash(size_t capacity)
+		{
+			if (capacity > (SIZE_MAX - kGroupSize) / (sizeof(Slot) + 1))
+				throw std::bad_alloc{};
+			FlatHashMap other{ _buffer.allocator() };
+			other._buffer.reserve(capacity * (sizeof(Slot) + 1) + kGroupSize, false);
+			other._capacity = capacity;
+			other._growthLeft = maxSize(capacity) - _size;
+			resetControl(other.control(), capacity);
+			for (size_t i = 0; i < _capacity; ++i)
+			{
+				const auto h2 = control()[i];
+				if (h2 < 0)
+					continue;
+				auto& slot = slots()[i];
+				const auto index = other.findFreeIndex(hashOf(slot._key));
+				new (other.slots() + index) Slot{ std::move(slot) };
+				std::destroy_at(&slot);
+				other.setControl(index, h2);
+			}
+			if (_capacity)
+				resetControl(control(), _capacity); // The slots have been moved out.
+			other._size = std::exchange(_size, size_t{});
+			swap(*this, other);
+		}
+
+		void setControl(size_t index, int8_t value) noexcept
+		{
+			control()[index] = value;
+			if (index < kGroupSize)
+				control()[_capacity + index] = value;
+		}
+
+		Buffer<std::byte, A> _buffer; // Slots followed by control bytes.
+		size_t _capacity = 0;
+		size_t _size = 0;
+		size_t _growthLeft = 0;
+	};
+}
@@ -0,0 +1,251 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/buffer.hpp>
+#include <primal/intrinsics.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace primal
+{
+	template <typename K, typename V, typename A>
+	class FlatMap;
+
+	// Immutable sorted set of trivially copyable keys which is built once and then only searched.
+	// Keys are stored in Eytzinger (breadth-first) order, so the first levels of the search tree
+	// share cache lines and the nodes several levels below the current one can be prefetched.
+	// Searches are branchless and batch searches interleave several keys to overlap cache misses.
+	template <typename K, typename A = AlignedAllocator<64>>
+	class FlatSet
+	{
+	public:
+		static_assert(std::is_trivially_copyable_v<K>);
+
+		constexpr FlatSet() noexcept = default;
+		FlatSet(const FlatSet&) = delete;
+		FlatSet& operator=(const FlatSet&) = delete;
+
+		// Builds the set from strictly increasing keys.
+		explicit FlatSet(std::span<const K> sortedKeys)
+			: _keys{ sortedKeys.size() + 1 }
+			, _size{ sortedKeys.size() }
+		{
+			assert(std::adjacent_find(sortedKeys.begin(), sortedKeys.end(), [](const K& left, const K& right) { return !(left < right); }) == sortedKeys.end());
+			const auto keys = _keys.data();
+			keys[0] = K{}; // Read (and ignored) by batch searches.
+			forEachInOrder(_size, [keys, sortedKeys](size_t index, size_t node) { keys[node] = sortedKeys[index]; });
+		}
+
+		constexpr FlatSet(FlatSet&& other) noexcept
+			: _keys{ std::move(other._keys) }
+			, _size{ std::exchange(other._size, size_t{}) }
+		{
+		}
+
+		constexpr FlatSet& operator=(FlatSet&& other) noexcept
+		{
+			swap(*this, other);
+			return *this;
+		}
+
+		[[nodiscard]] bool contains(const K& key) const noexcept { return findNode(key); }
+		[[nodiscard]] constexpr bool empty() const noexcept { return !_size; }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _size; }
+
+		// Checks every key and stores the results to the corresponding elements of the output span.
+		void contains(std::span<const K> keys, std::span<bool> results) const noexcept
+		{
+			assert(results.size() >= keys.size());
+			lowerBoundBatch(keys, [this, keys, results](size_t i, size_t node) { results[i] = isMatch(node, keys[i]); });
+		}
+
+		// Returns a pointer to the first key which is not less than the specified one, or nullptr if there is no such key.
+		[[nodiscard]] const K* lower_bound(const K& key) const noexcept
+		{
+			const auto node = lowerBoundNode(key);
+			return node ? _keys.data() + node : nullptr;
+		}
+
+		friend constexpr void swap(FlatSet& first, FlatSet& second) noexcept
+		{
+			using std::swap;
+			swap(first._keys, second._keys);
+			swap(first._size, second._size);
+		}
+
+	private:
+		// Number of keys in a cache line, i.e. the number of nodes four levels below for 4-byte keys.
+		static constexpr size_t kPrefetchStride = sizeof(K) < 64 ? std::bit_floor(64 / sizeof(K)) : 1;
+
+		// Number of keys which are searched simultaneously in batch searches.
+		static constexpr size_t kBatchSize = 16;
+
+		// Calls the function with sorted indices and the corresponding nodes.
+		template <typename F>
+		static void forEachInOrder(size_t size, F&& function)
+		{
+			if (!size)
+				return;
+			size_t node = 1;
+			while (node * 2 <= size)
+				node *= 2;
+			for (size_t index = 0; node; ++index)
+			{
+				function(index, node);
+				if (node * 2 + 1 <= size)
+				{
+					node = node * 2 + 1;
+					while (node * 2 <= size)
+						node *= 2;
+				}
+				else
+					node >>= std::countr_one(node) + 1; // Up to the first ancestor which has this node in its left subtree.
+			}
+		}
+
+		// Prefetches the nodes several levels below the specified one.
+		void prefetch(size_t node) const noexcept
+		{
+			// The address may be past the end of the keys, so it is computed without pointer arithmetic.
+			const auto address = reinterpret_cast<const char*>(reinterpret_cast<uintptr_t>(_keys.data()) + node * kPrefetchStride * sizeof(K));
+#if PRIMAL_INTRINSICS_SSE
+			_mm_prefetch(address, _MM_HINT_T0);
+#elif defined(__GNUC__)
+			__builtin_prefetch(address);
+#else
+			static_cast<void>(address);
+#endif
+		}
+
+		bool isMatch(size_t node, const K& key) const noexcept
+		{
+			return node && !(key < _keys.data()[node]);
+		}
+
+		size_t findNode(const K& key) const noexcept
+		{
+			const auto node = lowerBoundNode(key);
+			return isMatch(node, key) ? node : 0;
+		}
+
+		// Returns the node with the first key which is not less than the specified one, or zero if there is no such node.
+		size_t lowerBoundNode(const K& key) const noexcept
+		{
+			const auto keys = _keys.data();
+			size_t node = 1;
+			while (node <= _size)
+			{
+				prefetch(node);
+				node = node * 2 + size_t{ keys[node] < key };
+			}
+			// The search descends right after every key less than the specified one,
+			// so the answer is the last node where it has descended left.
+			return node >> (std::countr_one(node) + 1);
+		}
+
+		// Searches kBatchSize keys at a time. All levels except the last one are complete,
+		// so all searches in a batch can take the same number of steps without bound checks.
+		template <typename F>
+		void lowerBoundBatch(std::span<const K> keys, F&& function) const noexcept
+		{
+			const auto data = _keys.data();
+			const auto depth = static_cast<size_t>(std::bit_width(_size));
+			size_t i = 0;
+			for (; _size && i + kBatchSize <= keys.size(); i += kBatchSize)
+			{
+				size_t nodes[kBatchSize];
+				std::fill_n(nodes, kBatchSize, size_t{ 1 });
+				for (size_t level = 1; level < depth; ++level)
+					for (size_t j = 0; j < kBatchSize; ++j)
+					{
+						prefetch(nodes[j]);
+						nodes[j] = nodes[j] * 2 + size_t{ data[nodes[j]] < keys[i + j] };
+					}
+				for (size_t j = 0; j < kBatchSize; ++j)
+				{
+					const auto node = nodes[j] <= _size ? nodes[j] : 0; // The last level may be incomplete.
+					const auto next = nodes[j] * 2 + size_t{ data[node] < keys[i + j] };
+					nodes[j] = node ? next : nodes[j];
+					function(i + j, nodes[j] >> (std::countr_one(nodes[j]) + 1));
+				}
+			}
+			for (; i < keys.size(); ++i)
+				function(i, lowerBoundNode(keys[i]));
+		}
+
+		Buffer<K, A> _keys; // Nodes are numbered from one, so the children of node N are 2N and 2N+1.
+		size_t _size = 0;
+
+		template <typename, typename, typename>
+		friend class FlatMap;
+	};
+
+	// Immutable sorted map of trivially copyable keys and values with the same search as FlatSet.
+	template <typename K, typename V, typename A = AlignedAllocator<64>>
+	class FlatMap
+	{
+	public:
+		static_assert(std::is_trivially_copyable_v<V>);
+
+		constexpr FlatMap() noexcept = default;
+		FlatMap(const FlatMap&) = delete;
+		FlatMap& operator=(const FlatMap&) = delete;
+
+		// Builds the map from strictly increasing keys and the corresponding values.
+		FlatMap(std::span<const K> sortedKeys, std::span<const V> values)
+			: _keys{ sortedKeys }
+			, _values{ sortedKeys.size() + 1 }
+		{
+			assert(values.size() == sortedKeys.size());
+			const auto data = _values.data();
+			FlatSet<K, A>::forEachInOrder(_keys._size, [data, values](size_t index, size_t node) { data[node] = values[index]; });
+		}
+
+		constexpr FlatMap(FlatMap&&) noexcept = default;
+		constexpr FlatMap& operator=(FlatMap&&) noexcept = default;
+
+		[[nodiscard]] bool contains(const K& key) const noexcept { return _keys.findNode(key); }
+		[[nodiscard]] constexpr bool empty() const noexcept { return _keys.empty(); }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _keys.size(); }
+
+		// Returns a pointer to the value, or nullptr if there is no such key.
+		[[nodiscard]] V* find(const K& key) noexcept
+		{
+			const auto node = _keys.findNode(key);
+			return node ? _values.data() + node : nullptr;
+		}
+
+		[[nodiscard]] const V* find(const K& key) const noexcept
+		{
+			const auto node = _keys.findNode(key);
+			return node ? _values.data() + node : nullptr;
+		}
+
+		// Looks up every key and stores pointers to the values (or nullptr) to the corresponding elements of the output span.
+		void find(std::span<const K> keys, std::span<const V*> results) const noexcept
+		{
+			assert(results.size() >= keys.size());
+			_keys.lowerBoundBatch(keys, [this, keys, results](size_t i, size_t node) { results[i] = _keys.isMatch(node, keys[i]) ? _values.data() + node : nullptr; });
+		}
+
+		friend constexpr void swap(FlatMap& first, FlatMap& second) noexcept
+		{
+			using std::swap;
+			swap(first._keys, second._keys);
+			swap(first._values, second._values);
+		}
+
+	private:
+		FlatSet<K, A> _keys;
+		Buffer<V, A> _values; // In the same order as the keys.
+	};
+}
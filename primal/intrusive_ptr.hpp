@@ -0,0 +1,169 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace primal
+{
+	// Reference counting policy for objects shared between threads.
+	class AtomicRefCount
+	{
+	public:
+		using Counter = std::atomic<size_t>;
+
+		static void acquire(Counter& counter) noexcept
+		{
+			counter.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// Returns true if the last reference has been released.
+		static bool release(Counter& counter) noexcept
+		{
+			if (counter.fetch_sub(1, std::memory_order_release) != 1)
+				return false;
+			std::atomic_thread_fence(std::memory_order_acquire); // Makes all writes from other owners visible to the deleter.
+			return true;
+		}
+	};
+
+	// Reference counting policy for objects which never leave their thread.
+	class LocalRefCount
+	{
+	public:
+		using Counter = size_t;
+
+		static void acquire(Counter& counter) noexcept
+		{
+			++counter;
+		}
+
+		static bool release(Counter& counter) noexcept
+		{
+			return !--counter;
+		}
+	};
+
+	template <typename T, typename Policy, typename Deleter>
+	class IntrusivePtr;
+
+	// Base class for objects owned by IntrusivePtr.
+	// New objects have no references, and copies of objects don't inherit references.
+	template <typename Policy = AtomicRefCount>
+	class RefCounted
+	{
+	public:
+		constexpr RefCounted() noexcept = default;
+		constexpr RefCounted(const RefCounted&) noexcept {}
+		constexpr RefCounted& operator=(const RefCounted&) noexcept { return *this; }
+
+	protected:
+		~RefCounted() noexcept = default;
+
+	private:
+		mutable typename Policy::Counter _references{ 0 };
+
+		template <typename, typename, typename>
+		friend class IntrusivePtr;
+	};
+
+	// Deleter for objects created with new.
+	class DefaultDeleter
+	{
+	public:
+		template <typename T>
+		static void free(T* pointer) noexcept
+		{
+			delete pointer;
+		}
+	};
+
+	// Shared ownership smart pointer which keeps the reference counter inside the object (in a RefCounted base)
+	// and passes the object to the deleter when the last reference is released.
+	template <typename T, typename Policy = AtomicRefCount, typename Deleter = DefaultDeleter>
+	class IntrusivePtr : private Deleter
+	{
+	public:
+		constexpr IntrusivePtr() noexcept = default;
+		~IntrusivePtr() noexcept { release(_pointer); }
+
+		template <typename... DeleterArgs>
+		explicit IntrusivePtr(T* pointer, DeleterArgs&&... args) noexcept
+			: Deleter{ std::forward<DeleterArgs>(args)... }, _pointer{ pointer }
+		{
+			acquire();
+		}
+
+		IntrusivePtr(const IntrusivePtr& other) noexcept
+			: Deleter{ static_cast<const Deleter&>(other) }, _pointer{ other._pointer }
+		{
+			acquire();
+		}
+
+		constexpr IntrusivePtr(IntrusivePtr&& other) noexcept
+			: Deleter{ static_cast<Deleter&&>(other) }, _pointer{ std::exchange(other._pointer, nullptr) } {}
+
+		IntrusivePtr& operator=(const IntrusivePtr& other) noexcept
+		{
+			IntrusivePtr copy{ other };
+			swap(*this, copy);
+			return *this;
+		}
+
+		constexpr IntrusivePtr& operator=(IntrusivePtr&& other) noexcept
+		{
+			swap(*this, other);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr operator T*() const noexcept { return _pointer; }
+		[[nodiscard]] constexpr T* operator->() const noexcept { return _pointer; }
+		[[nodiscard]] constexpr Deleter& deleter() noexcept { return *this; }
+		[[nodiscard]] constexpr const Deleter& deleter() const noexcept { return *this; }
+		[[nodiscard]] constexpr T* get() const noexcept { return _pointer; }
+
+		void reset(T* pointer = nullptr) noexcept
+		{
+			if (_pointer != pointer)
+			{
+				const auto old = std::exchange(_pointer, pointer);
+				acquire(); // Before releasing the old object in case it owns the new one.
+				release(old);
+			}
+		}
+
+		friend constexpr void swap(IntrusivePtr& first, IntrusivePtr& second) noexcept
+		{
+			using std::swap;
+			if constexpr (sizeof(IntrusivePtr) > sizeof(void*))
+				swap(static_cast<Deleter&>(first), static_cast<Deleter&>(second));
+			swap(first._pointer, second._pointer);
+		}
+
+	private:
+		static typename Policy::Counter& counter(T* pointer) noexcept
+		{
+			static_assert(std::is_base_of_v<RefCounted<Policy>, T>); // Here rather than in the class body to allow incomplete types.
+			return static_cast<const RefCounted<Policy>*>(pointer)->_references;
+		}
+
+		void acquire() noexcept
+		{
+			if (_pointer)
+				Policy::acquire(counter(_pointer));
+		}
+
+		void release(T* pointer) noexcept
+		{
+			if (pointer && Policy::release(counter(pointer)))
+				Deleter::free(pointer);
+		}
+
+		T* _pointer = nullptr;
+	};
+}
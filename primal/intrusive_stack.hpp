@@ -0,0 +1,76 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/tagged_pointer.hpp>
+
+#include <atomic>
+#include <type_traits>
+
+namespace primal
+{
+	// Base class for elements of intrusive lock-free containers.
+	// An element may be in only one container at a time.
+	class IntrusiveNode
+	{
+	public:
+		std::atomic<IntrusiveNode*> _next{ nullptr };
+	};
+
+	// Lock-free LIFO list (Treiber stack) of elements derived from IntrusiveNode.
+	// Popping reads the link of the top element which may have just been popped by another thread,
+	// so the memory of popped elements must remain readable (e.g. they may be reused, but not unmapped).
+	template <typename T>
+	class IntrusiveStack
+	{
+	public:
+		static_assert(std::is_base_of_v<IntrusiveNode, T>);
+		static_assert(std::atomic<TaggedPointer<IntrusiveNode>>::is_always_lock_free);
+
+		constexpr IntrusiveStack() noexcept = default;
+		IntrusiveStack(const IntrusiveStack&) = delete;
+		IntrusiveStack& operator=(const IntrusiveStack&) = delete;
+
+		// The result may be outdated by the time it is returned.
+		[[nodiscard]] bool empty() const noexcept { return !_top.load(std::memory_order_relaxed).pointer(); }
+
+		// Returns the top element or nullptr if the stack is empty.
+		[[nodiscard]] T* pop() noexcept
+		{
+			auto top = _top.load(std::memory_order_acquire);
+			while (const auto node = top.pointer())
+				if (_top.compare_exchange_weak(top, { node->_next.load(std::memory_order_relaxed), top.tag() + 1 }, std::memory_order_acquire, std::memory_order_acquire))
+					return static_cast<T*>(node);
+			return nullptr;
+		}
+
+		// Takes all elements at once and returns the former top element.
+		// The remaining elements are accessible through the links.
+		[[nodiscard]] T* popAll() noexcept
+		{
+			auto top = _top.load(std::memory_order_relaxed);
+			while (!_top.compare_exchange_weak(top, { nullptr, top.tag() + 1 }, std::memory_order_acquire, std::memory_order_relaxed))
+				;
+			return static_cast<T*>(top.pointer());
+		}
+
+		void push(T* element) noexcept
+		{
+			pushList(element, element);
+		}
+
+		// Pushes a list of elements linked from the first one to the last one.
+		void pushList(T* first, T* last) noexcept
+		{
+			auto top = _top.load(std::memory_order_relaxed);
+			do
+				static_cast<IntrusiveNode*>(last)->_next.store(top.pointer(), std::memory_order_relaxed);
+			while (!_top.compare_exchange_weak(top, { first, top.tag() + 1 }, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+	private:
+		std::atomic<TaggedPointer<IntrusiveNode>> _top;
+	};
+}
@@ -0,0 +1,243 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/allocator.hpp>
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#	include <sys/mman.h>
+#	ifdef __linux__
+#		include <fcntl.h>
+#		include <sys/syscall.h>
+#		include <unistd.h>
+#	endif
+#endif
+
+namespace primal
+{
+	// NUMA policy which leaves page placement to the system.
+	class NoNumaBinding
+	{
+	public:
+		static void bind(void*, size_t) noexcept {}
+	};
+
+	// NUMA policy which binds pages to the specified node.
+	// Binding is best-effort and is silently skipped if the system doesn't support it.
+	template <unsigned kNode>
+	class NumaNodeBinding
+	{
+	public:
+		static void bind([[maybe_unused]] void* memory, [[maybe_unused]] size_t size) noexcept
+		{
+#if defined(__linux__) && defined(SYS_mbind)
+			constexpr int kMpolBind = 2;
+			constexpr auto kMaskBits = 8 * sizeof(unsigned long);
+			unsigned long mask[kNode / kMaskBits + 1]{};
+			mask[kNode / kMaskBits] = 1ul << (kNode % kMaskBits);
+			::syscall(SYS_mbind, memory, size, kMpolBind, mask, sizeof mask * 8 + 1, 0u);
+#endif
+		}
+	};
+
+	// Allocator which maps large blocks directly from the system using huge pages if possible.
+	// Explicit huge pages (MAP_HUGETLB) are tried first, then transparent huge pages (MADV_HUGEPAGE),
+	// then regular pages. Small blocks are allocated from the heap. All blocks are kAlignment-aligned.
+	// If a MAP_HUGETLB mapping fails (usually because the preallocated huge pages are exhausted),
+	// the next kHugeTlbRetryInterval mappings skip it.
+	template <typename NumaPolicy = NoNumaBinding>
+	class LargePageAllocator
+	{
+	public:
+		static constexpr size_t kAlignment = 64;
+		static constexpr unsigned kHugeTlbRetryInterval = 64;
+
+		[[nodiscard]] static void* allocate(size_t size)
+		{
+			const auto pageSize = hugePageSize();
+			if (size > SIZE_MAX - pageSize)
+				throw std::bad_alloc{};
+			Header* header;
+#ifndef _WIN32
+			if (isMapped(size))
+				header = static_cast<Header*>(mapHugePages((size + kAlignment + pageSize - 1) & ~(pageSize - 1)));
+			else
+#endif
+			{
+				header = static_cast<Header*>(AlignedAllocator<kAlignment>::allocate(size + kAlignment));
+				header->_mappedSize = 0;
+			}
+			header->_size = size;
+			return reinterpret_cast<std::byte*>(header) + kAlignment;
+		}
+
+		// Mapped blocks are zero-filled by the system when their pages are first touched.
+		[[nodiscard]] static void* allocateZeroed(size_t size)
+		{
+			const auto memory = allocate(size);
+#ifndef _WIN32
+			if (!isMapped(size))
+#endif
+				std::memset(memory, 0, size);
+			return memory;
+		}
+
+		// Mapped blocks are resized with mremap() which doesn't copy their contents,
+		// and are moved only to huge page aligned addresses.
+		// Blocks which can't be remapped (e.g. MAP_HUGETLB ones) are reallocated and copied.
+		[[nodiscard]] static void* reallocate(void* memory, size_t size)
+		{
+			const auto header = reinterpret_cast<Header*>(static_cast<std::byte*>(memory) - kAlignment);
+#ifdef MREMAP_MAYMOVE
+			if (header->_mappedSize && isMapped(size))
+			{
+				const auto pageSize = hugePageSize();
+				if (size > SIZE_MAX - pageSize)
+					throw std::bad_alloc{};
+				const auto mappedSize = (size + kAlignment + pageSize - 1) & ~(pageSize - 1);
+				if (mappedSize == header->_mappedSize)
+				{
+					header->_size = size;
+					return memory;
+				}
+				auto remapped = ::mremap(header, header->_mappedSize, mappedSize, 0);
+				if (remapped == MAP_FAILED)
+					if (const auto target = mapAligned(mappedSize))
+					{
+						remapped = ::mremap(header, header->_mappedSize, mappedSize, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+						if (remapped == MAP_FAILED)
+							::munmap(target, mappedSize);
+					}
+				if (remapped != MAP_FAILED)
+				{
+#	ifdef MADV_HUGEPAGE
+					::madvise(remapped, mappedSize, MADV_HUGEPAGE);
+#	endif
+					NumaPolicy::bind(remapped, mappedSize);
+					const auto newHeader = static_cast<Header*>(remapped);
+					newHeader->_mappedSize = mappedSize;
+					newHeader->_size = size;
+					return static_cast<std::byte*>(remapped) + kAlignment;
+				}
+			}
+#endif
+			const auto newMemory = allocate(size);
+			std::memcpy(newMemory, memory, size < header->_size ? size : header->_size);
+			deallocate(memory);
+			return newMemory;
+		}
+
+		static void deallocate(void* memory) noexcept
+		{
+			if (!memory)
+				return;
+			const auto header = reinterpret_cast<Header*>(static_cast<std::byte*>(memory) - kAlignment);
+#ifndef _WIN32
+			if (header->_mappedSize)
+			{
+				::munmap(header, header->_mappedSize);
+				return;
+			}
+#endif
+			AlignedAllocator<kAlignment>::deallocate(header);
+		}
+
+		// Returns the size of huge pages which are used for mapped blocks.
+		// On Linux, it is the transparent huge page size reported by the system (2 MiB on x86-64),
+		// and explicit huge pages of the same size are requested. Otherwise, it is 2 MiB.
+		[[nodiscard]] static size_t hugePageSize() noexcept
+		{
+			static const auto size = [] {
+				size_t result = size_t{ 1 } << 21;
+#ifdef __linux__
+				if (const auto file = ::open("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", O_RDONLY | O_CLOEXEC); file != -1)
+				{
+					char buffer[32];
+					const auto length = ::read(file, buffer, sizeof buffer);
+					::close(file);
+					size_t value = 0;
+					for (ptrdiff_t i = 0; i < length && buffer[i] >= '0' && buffer[i] <= '9'; ++i)
+						value = value * 10 + static_cast<size_t>(buffer[i] - '0');
+					if (value >= kAlignment && std::has_single_bit(value))
+						result = value;
+				}
+#endif
+				return result;
+			}();
+			return size;
+		}
+
+	private:
+		struct Header
+		{
+			size_t _mappedSize;
+			size_t _size;
+		};
+
+		static_assert(sizeof(Header) <= kAlignment);
+
+		static bool isMapped(size_t size) noexcept { return size + kAlignment >= hugePageSize(); }
+
+#ifndef _WIN32
+		// Transparent huge pages require huge page alignment, so we map more and trim the excess.
+		static void* mapAligned(size_t size) noexcept
+		{
+			const auto pageSize = hugePageSize();
+			const auto mapped = ::mmap(nullptr, size + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (mapped == MAP_FAILED)
+				return nullptr;
+			const auto begin = reinterpret_cast<uintptr_t>(mapped);
+			const auto alignedBegin = (begin + pageSize - 1) & ~(pageSize - 1);
+			if (alignedBegin > begin)
+				::munmap(mapped, alignedBegin - begin);
+			if (const auto tailSize = begin + pageSize - alignedBegin; tailSize > 0)
+				::munmap(reinterpret_cast<void*>(alignedBegin + size), tailSize);
+			return reinterpret_cast<void*>(alignedBegin);
+		}
+
+		static void* mapHugePages(size_t size)
+		{
+			void* memory = MAP_FAILED;
+#	ifdef MAP_HUGETLB
+			static std::atomic<unsigned> hugeTlbSkips{ 0 };
+			if (auto skips = hugeTlbSkips.load(std::memory_order_relaxed); skips > 0)
+				hugeTlbSkips.compare_exchange_strong(skips, skips - 1, std::memory_order_relaxed);
+			else
+			{
+				auto flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#		ifdef MAP_HUGE_SHIFT
+				flags |= std::countr_zero(hugePageSize()) << MAP_HUGE_SHIFT; // Otherwise the default huge page size (which may be 1 GiB) is used.
+#		endif
+				memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+				if (memory == MAP_FAILED)
+					hugeTlbSkips.store(kHugeTlbRetryInterval, std::memory_order_relaxed);
+			}
+#	endif
+			if (memory == MAP_FAILED)
+			{
+				memory = mapAligned(size);
+				if (!memory)
+					throw std::bad_alloc{};
+#	ifdef MADV_HUGEPAGE
+				::madvise(memory, size, MADV_HUGEPAGE);
+#	endif
+			}
+			NumaPolicy::bind(memory, size);
+			static_cast<Header*>(memory)->_mappedSize = size;
+			return memory;
+		}
+#endif
+	};
+
+	template <typename NumaPolicy>
+	constexpr size_t kAllocatorAlignment<LargePageAllocator<NumaPolicy>> = LargePageAllocator<NumaPolicy>::kAlignment;
+}
@@ -0,0 +1,144 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/pointer.hpp>
+#include <primal/scope.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <utility>
+
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace primal
+{
+	// Read-only memory mapping of a whole file.
+	class MappedFile
+	{
+	public:
+		// Expected access pattern for the mapped data.
+		enum class Advice
+		{
+			Normal,     // No special treatment.
+			Sequential, // Aggressive read-ahead, pages may be freed soon after access.
+			Random,     // No read-ahead.
+			WillNeed,   // Start reading the whole file in the background.
+			HugePage,   // Back the mapping with huge pages if possible.
+		};
+
+		constexpr MappedFile() noexcept = default;
+
+		// Maps the file, optionally reading all its contents into memory immediately.
+		// Returns an empty MappedFile if the file can't be opened or is empty.
+		[[nodiscard]] static MappedFile open(const std::filesystem::path& path, bool populate = false) noexcept
+		{
+#ifdef _WIN32
+			const auto file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+				return {};
+			PRIMAL_FINALLY([file] { ::CloseHandle(file); });
+			LARGE_INTEGER fileSize;
+			if (!::GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0 || static_cast<unsigned long long>(fileSize.QuadPart) > SIZE_MAX)
+				return {};
+			const auto mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!mapping)
+				return {};
+			PRIMAL_FINALLY([mapping] { ::CloseHandle(mapping); });
+			const auto data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if (!data)
+				return {};
+			const auto size = static_cast<size_t>(fileSize.QuadPart);
+			if (populate)
+			{
+				WIN32_MEMORY_RANGE_ENTRY range{ data, size };
+				::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+			}
+			return MappedFile{ static_cast<const std::byte*>(data), size };
+#else
+			const auto file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (file == -1)
+				return {};
+			PRIMAL_FINALLY([file] { ::close(file); });
+			struct stat status;
+			if (::fstat(file, &status) == -1 || status.st_size <= 0 || static_cast<unsigned long long>(status.st_size) > SIZE_MAX)
+				return {};
+			const auto size = static_cast<size_t>(status.st_size);
+			auto flags = MAP_PRIVATE;
+#	ifdef MAP_POPULATE
+			if (populate)
+				flags |= MAP_POPULATE;
+#	else
+			static_cast<void>(populate);
+#	endif
+			const auto data = ::mmap(nullptr, size, PROT_READ, flags, file, 0);
+			if (data == MAP_FAILED)
+				return {};
+			return MappedFile{ static_cast<const std::byte*>(data), size };
+#endif
+		}
+
+		[[nodiscard]] constexpr const std::byte* data() const noexcept { return _data; }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _data.deleter().size(); }
+
+		// Returns false if the advice isn't supported.
+		bool advise(Advice advice) const noexcept
+		{
+			if (!_data)
+				return false;
+#ifdef _WIN32
+			switch (advice)
+			{
+			case Advice::Normal: return true;
+			case Advice::WillNeed:
+			{
+				WIN32_MEMORY_RANGE_ENTRY range{ const_cast<std::byte*>(_data.get()), size() };
+				return ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+			}
+			default: return false;
+			}
+#else
+			int value = MADV_NORMAL;
+			switch (advice)
+			{
+			case Advice::Normal: break;
+			case Advice::Sequential: value = MADV_SEQUENTIAL; break;
+			case Advice::Random: value = MADV_RANDOM; break;
+			case Advice::WillNeed: value = MADV_WILLNEED; break;
+			case Advice::HugePage:
+#	ifdef MADV_HUGEPAGE
+				value = MADV_HUGEPAGE;
+				break;
+#	else
+				return false;
+#	endif
+			}
+			return !::madvise(const_cast<std::byte*>(_data.get()), size(), value);
+#endif
+		}
+
+	private:
+		static void unmap(const std::byte* data, [[maybe_unused]] size_t size) noexcept
+		{
+#ifdef _WIN32
+			::UnmapViewOfFile(data);
+#else
+			::munmap(const_cast<std::byte*>(data), size);
+#endif
+		}
+
+		constexpr MappedFile(const std::byte* data, size_t size) noexcept
+			: _data{ data, size } {}
+
+		Pointer<const std::byte, SizedFunctionDeleter<unmap>> _data;
+	};
+}
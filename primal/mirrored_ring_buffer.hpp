@@ -0,0 +1,178 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/pointer.hpp>
+#include <primal/scope.hpp>
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <utility>
+
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#	include <unistd.h>
+#	ifndef __linux__
+#		include <fcntl.h>
+#		include <cstdio>
+#	endif
+#endif
+
+namespace primal
+{
+	// Byte ring buffer whose memory is mapped twice in a row, so any region
+	// of up to size() bytes starting inside the buffer is contiguous.
+	// The memory is page-aligned, so regions stay aligned as long as all commits
+	// are multiples of the required alignment. The ring isn't thread-safe.
+	class MirroredRingBuffer
+	{
+	public:
+		constexpr MirroredRingBuffer() noexcept = default;
+
+		// The size is rounded up to a power of two which is a multiple of the allocation granularity
+		// (a page on POSIX systems).
+		explicit MirroredRingBuffer(size_t size)
+		{
+			if (size > SIZE_MAX >> 2)
+				throw std::bad_alloc{};
+			const auto granularity = allocationGranularity();
+			size = std::bit_ceil(size > granularity ? size : granularity);
+			_data = Pointer<std::byte, SizedFunctionDeleter<unmap>>{ mapMirrored(size), size };
+		}
+
+		constexpr MirroredRingBuffer(MirroredRingBuffer&& other) noexcept
+			: _data{ std::move(other._data) }
+			, _readPosition{ std::exchange(other._readPosition, size_t{}) }
+			, _writePosition{ std::exchange(other._writePosition, size_t{}) }
+		{
+		}
+
+		constexpr MirroredRingBuffer& operator=(MirroredRingBuffer&& other) noexcept
+		{
+			swap(*this, other);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr std::byte* data() noexcept { return _data; }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _data.deleter().size(); }
+		[[nodiscard]] constexpr size_t readable() const noexcept { return _writePosition - _readPosition; }
+		[[nodiscard]] constexpr size_t writable() const noexcept { return size() - readable(); }
+
+		// Returns all free space as a single region.
+		[[nodiscard]] constexpr std::span<std::byte> writeRegion() noexcept
+		{
+			return { _data.get() + (_writePosition & (size() - 1)), writable() };
+		}
+
+		// Returns all filled space as a single region.
+		[[nodiscard]] constexpr std::span<const std::byte> readRegion() const noexcept
+		{
+			return { _data.get() + (_readPosition & (size() - 1)), readable() };
+		}
+
+		constexpr void commitWrite(size_t size) noexcept
+		{
+			assert(size <= writable());
+			_writePosition += size;
+		}
+
+		constexpr void commitRead(size_t size) noexcept
+		{
+			assert(size <= readable());
+			_readPosition += size;
+		}
+
+		friend constexpr void swap(MirroredRingBuffer& first, MirroredRingBuffer& second) noexcept
+		{
+			using std::swap;
+			swap(first._data, second._data);
+			swap(first._readPosition, second._readPosition);
+			swap(first._writePosition, second._writePosition);
+		}
+
+	private:
+		static void unmap(std::byte* data, size_t size) noexcept
+		{
+#ifdef _WIN32
+			::UnmapViewOfFile(data + size);
+			::UnmapViewOfFile(data);
+#else
+			::munmap(data, 2 * size);
+#endif
+		}
+
+		static size_t allocationGranularity() noexcept
+		{
+#ifdef _WIN32
+			SYSTEM_INFO info;
+			::GetSystemInfo(&info);
+			return info.dwAllocationGranularity;
+#else
+			return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+		}
+
+		static std::byte* mapMirrored(size_t size)
+		{
+#ifdef _WIN32
+			const auto mapping = ::CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(uint64_t{ size } >> 32), static_cast<DWORD>(size), nullptr);
+			if (!mapping)
+				throw std::bad_alloc{};
+			PRIMAL_FINALLY([mapping] { ::CloseHandle(mapping); });
+			// Another thread may take the address range between freeing and mapping it, so we retry a few times.
+			for (int attempt = 0; attempt < 16; ++attempt)
+			{
+				const auto range = static_cast<std::byte*>(::VirtualAlloc(nullptr, 2 * size, MEM_RESERVE, PAGE_NOACCESS));
+				if (!range)
+					break;
+				::VirtualFree(range, 0, MEM_RELEASE);
+				const auto first = ::MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size, range);
+				if (!first)
+					continue;
+				if (::MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size, range + size))
+					return range;
+				::UnmapViewOfFile(first);
+			}
+			throw std::bad_alloc{};
+#else
+#	ifdef __linux__
+			const auto file = ::memfd_create("primal::MirroredRingBuffer", MFD_CLOEXEC);
+#	else
+			char name[32];
+			std::snprintf(name, sizeof name, "/primal-%ld-%p", static_cast<long>(::getpid()), static_cast<void*>(name));
+			const auto file = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+			if (file != -1)
+				::shm_unlink(name);
+#	endif
+			if (file == -1)
+				throw std::bad_alloc{};
+			PRIMAL_FINALLY([file] { ::close(file); });
+			if (::ftruncate(file, static_cast<off_t>(size)) == -1)
+				throw std::bad_alloc{};
+			// Reserve the whole range first so that both mappings can be placed in it with MAP_FIXED.
+			const auto range = static_cast<std::byte*>(::mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+			if (range == MAP_FAILED)
+				throw std::bad_alloc{};
+			if (::mmap(range, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, file, 0) == MAP_FAILED
+				|| ::mmap(range + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, file, 0) == MAP_FAILED)
+			{
+				::munmap(range, 2 * size);
+				throw std::bad_alloc{};
+			}
+			return range;
+#endif
+		}
+
+		Pointer<std::byte, SizedFunctionDeleter<unmap>> _data;
+		size_t _readPosition = 0;
+		size_t _writePosition = 0;
+	};
+}
@@ -0,0 +1,159 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/cache_line.hpp>
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace primal
+{
+	// Bounded lock-free FIFO queue with multiple producers and multiple consumers (Vyukov's algorithm)
+	// and preallocated storage (like StaticVector):
+	// * every slot has a sequence number which tells whether it is ready to be written or read in the current lap;
+	// * try_ functions fail instead of waiting if the queue is full (or empty);
+	// * blocking functions reserve a position in the queue and yield until its slot is ready;
+	// * element construction must not throw.
+	template <typename T, size_t kCapacity>
+	class MpmcQueue
+	{
+	public:
+		static_assert(std::has_single_bit(kCapacity));
+		static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>);
+
+		MpmcQueue() noexcept
+		{
+			for (size_t i = 0; i < kCapacity; ++i)
+				_slots[i]._sequence.store(i, std::memory_order_relaxed);
+		}
+
+		MpmcQueue(const MpmcQueue&) = delete;
+		MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+		~MpmcQueue() noexcept
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>)
+				for (auto i = _head.load(std::memory_order_relaxed), end = _tail.load(std::memory_order_relaxed); i != end; ++i)
+					std::destroy_at(_slots[i & kMask].value());
+		}
+
+		// Removes the oldest element, waiting for it if the queue is empty.
+		[[nodiscard]] T pop() noexcept
+		{
+			const auto position = _head.fetch_add(1, std::memory_order_relaxed);
+			auto& slot = _slots[position & kMask];
+			while (slot._sequence.load(std::memory_order_acquire) != position + 1)
+				std::this_thread::yield();
+			return consume(slot, position);
+		}
+
+		// Appends an element constructed from the arguments, waiting for free space if the queue is full.
+		template <typename... Args>
+		void push(Args&&... args) noexcept
+		{
+			static_assert(std::is_nothrow_constructible_v<T, Args&&...>, "Element construction must not throw");
+			const auto position = _tail.fetch_add(1, std::memory_order_relaxed);
+			auto& slot = _slots[position & kMask];
+			while (slot._sequence.load(std::memory_order_acquire) != position)
+				std::this_thread::yield();
+			produce(slot, position, std::forward<Args>(args)...);
+		}
+
+		// Removes the oldest element if the queue is not empty.
+		bool try_pop(T& value) noexcept
+		{
+			return try_pop_n(&value, 1);
+		}
+
+		// Removes up to the specified number of the oldest elements at once and returns the number of removed elements.
+		size_t try_pop_n(T* values, size_t maxCount) noexcept
+		{
+			if (!maxCount)
+				return 0;
+			auto position = _head.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				size_t count = 0;
+				while (count < maxCount && count < kCapacity && _slots[(position + count) & kMask]._sequence.load(std::memory_order_acquire) == position + count + 1)
+					++count;
+				if (!count)
+				{
+					if (static_cast<ptrdiff_t>(_slots[position & kMask]._sequence.load(std::memory_order_acquire) - (position + 1)) < 0)
+						return 0; // The slot hasn't been written in the current lap.
+					position = _head.load(std::memory_order_relaxed); // Another consumer has taken the element.
+				}
+				else if (_head.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+				{
+					// Only the consumer which owns a position can change its slot, so all checked slots are still ready.
+					for (size_t i = 0; i < count; ++i)
+						values[i] = consume(_slots[(position + i) & kMask], position + i);
+					return count;
+				}
+			}
+		}
+
+		// Appends an element constructed from the arguments if the queue is not full.
+		template <typename... Args>
+		bool try_push(Args&&... args) noexcept
+		{
+			static_assert(std::is_nothrow_constructible_v<T, Args&&...>, "Element construction must not throw");
+			auto position = _tail.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				auto& slot = _slots[position & kMask];
+				const auto difference = static_cast<ptrdiff_t>(slot._sequence.load(std::memory_order_acquire) - position);
+				if (!difference)
+				{
+					if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						produce(slot, position, std::forward<Args>(args)...);
+						return true;
+					}
+				}
+				else if (difference < 0)
+					return false; // The slot still contains an element from the previous lap.
+				else
+					position = _tail.load(std::memory_order_relaxed);
+			}
+		}
+
+	private:
+		static constexpr size_t kMask = kCapacity - 1;
+
+		struct Slot
+		{
+			std::atomic<size_t> _sequence; // Position for writing, position + 1 for reading.
+			std::aligned_storage_t<sizeof(T), alignof(T)> _value;
+
+			T* value() noexcept { return reinterpret_cast<T*>(&_value); }
+		};
+
+		static T consume(Slot& slot, size_t position) noexcept
+		{
+			T value{ std::move(*slot.value()) };
+			std::destroy_at(slot.value());
+			slot._sequence.store(position + kCapacity, std::memory_order_release);
+			return value;
+		}
+
+		template <typename... Args>
+		static void produce(Slot& slot, size_t position, Args&&... args) noexcept
+		{
+			new (slot.value()) T{ std::forward<Args>(args)... };
+			slot._sequence.store(position + 1, std::memory_order_release);
+		}
+
+		alignas(kCacheLineSize) std::atomic<size_t> _tail{ 0 }; // Next position for producers.
+		alignas(kCacheLineSize) std::atomic<size_t> _head{ 0 }; // Next position for consumers.
+		alignas(kCacheLineSize) Slot _slots[kCapacity];
+	};
+}
@@ -0,0 +1,73 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/cache_line.hpp>
+#include <primal/intrusive_stack.hpp>
+
+#include <atomic>
+#include <type_traits>
+
+namespace primal
+{
+	// Intrusive FIFO queue for elements derived from IntrusiveNode with multiple producers and a single consumer (Vyukov's algorithm):
+	// * pushing is wait-free and takes a single atomic exchange;
+	// * popping is lock-free, but may return nullptr while a preempted producer is between the steps of a push;
+	// * the queue doesn't own the elements.
+	template <typename T>
+	class MpscQueue
+	{
+	public:
+		static_assert(std::is_base_of_v<IntrusiveNode, T>);
+
+		MpscQueue() noexcept = default;
+		MpscQueue(const MpscQueue&) = delete;
+		MpscQueue& operator=(const MpscQueue&) = delete;
+
+		// Returns the oldest element or nullptr if there are no (completely pushed) elements. Must be called only by the consumer.
+		[[nodiscard]] T* pop() noexcept
+		{
+			auto tail = _tail;
+			auto next = tail->_next.load(std::memory_order_acquire);
+			if (tail == &_stub)
+			{
+				if (!next)
+					return nullptr;
+				_tail = next;
+				tail = next;
+				next = next->_next.load(std::memory_order_acquire);
+			}
+			if (!next)
+			{
+				if (tail != _head.load(std::memory_order_acquire))
+					return nullptr; // The next element is being pushed.
+				pushNode(&_stub); // The stub takes place of the last element, so that it can be popped.
+				next = tail->_next.load(std::memory_order_acquire);
+				if (!next)
+					return nullptr; // Another element is being pushed after the last one.
+			}
+			_tail = next;
+			return static_cast<T*>(tail);
+		}
+
+		void push(T* element) noexcept
+		{
+			pushNode(element);
+		}
+
+	private:
+
+		void pushNode(IntrusiveNode* node) noexcept
+		{
+			node->_next.store(nullptr, std::memory_order_relaxed);
+			const auto previous = _head.exchange(node, std::memory_order_acq_rel);
+			previous->_next.store(node, std::memory_order_release);
+		}
+
+		alignas(kCacheLineSize) std::atomic<IntrusiveNode*> _head{ &_stub }; // Most recently pushed element, shared by the producers.
+		alignas(kCacheLineSize) IntrusiveNode* _tail = &_stub; // Oldest element, owned by the consumer.
+		IntrusiveNode _stub;
+	};
+}
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <utility>
 
 namespace primal
@@ -32,6 +33,8 @@ namespace primal
 
 		[[nodiscard]] constexpr operator T*() const noexcept { return _pointer; }
 		[[nodiscard]] constexpr T* operator->() const noexcept { return _pointer; }
+		[[nodiscard]] constexpr Deleter& deleter() noexcept { return *this; }
+		[[nodiscard]] constexpr const Deleter& deleter() const noexcept { return *this; }
 		[[nodiscard]] constexpr T* get() const noexcept { return _pointer; }
 		[[nodiscard]] constexpr T** out() noexcept { return &_pointer; }
 
@@ -68,6 +71,38 @@ namespace primal
 		}
 	};
 
+	// Deleter which calls a function with the pointer and the size it was created with,
+	// e.g. for memory mappings.
+	template <auto deleter>
+	class SizedFunctionDeleter
+	{
+	public:
+		constexpr SizedFunctionDeleter() noexcept = default;
+
+		constexpr explicit SizedFunctionDeleter(size_t size) noexcept
+			: _size{ size } {}
+
+		constexpr SizedFunctionDeleter(SizedFunctionDeleter&& other) noexcept
+			: _size{ std::exchange(other._size, size_t{}) } {}
+
+		[[nodiscard]] constexpr size_t size() const noexcept { return _size; }
+
+		template <typename T>
+		void free(T* pointer) noexcept
+		{
+			if (pointer)
+				deleter(pointer, _size);
+		}
+
+		friend constexpr void swap(SizedFunctionDeleter& first, SizedFunctionDeleter& second) noexcept
+		{
+			std::swap(first._size, second._size);
+		}
+
+	private:
+		size_t _size = 0;
+	};
+
 	// Smart pointer for working with C APIs.
 	template <typename T, auto deleter>
 	using CPtr = Pointer<T, FunctionDeleter<deleter>>;
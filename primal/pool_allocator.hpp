@@ -0,0 +1,187 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/allocator.hpp>
+#include <primal/cache_line.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace primal
+{
+	// Allocator for small blocks which uses per-thread size-class free lists.
+	// Blocks freed by other threads are returned to the owning thread through lock-free lists,
+	// and caches of exited threads are adopted by new threads. Pooled memory is never released
+	// to the system. Requests larger than kMaxSize, and requests made during thread exit after
+	// the thread's cache has been released, are forwarded to Allocator.
+	class PoolAllocator
+	{
+	public:
+		static constexpr size_t kMaxSize = 256;
+
+		[[nodiscard]] static void* allocate(size_t size)
+		{
+			if (size > kMaxSize)
+				[[unlikely]]
+				return allocateLarge(size);
+			auto cache = _cache;
+			if (!cache)
+				[[unlikely]]
+			{
+				if (_cacheReleased)
+					return allocateLarge(size);
+				cache = acquireCache();
+			}
+			auto& bin = cache->_bins[binIndex(size)];
+			auto block = bin._free;
+			if (!block)
+				[[unlikely]]
+				block = refill(bin, binIndex(size));
+			bin._free = block->_next;
+			return block;
+		}
+
+		static void deallocate(void* memory) noexcept
+		{
+			if (!memory)
+				return;
+			const auto header = reinterpret_cast<Bin**>(memory) - 1;
+			const auto bin = *header;
+			if (!bin)
+			{
+				Allocator::deallocate(header - 1);
+				return;
+			}
+			const auto block = static_cast<Block*>(memory);
+			if (const auto cache = _cache; cache && reinterpret_cast<uintptr_t>(bin) - reinterpret_cast<uintptr_t>(cache->_bins) < sizeof cache->_bins)
+			{
+				block->_next = bin->_free;
+				bin->_free = block;
+				return;
+			}
+			block->_next = bin->_remote.load(std::memory_order_relaxed);
+			while (!bin->_remote.compare_exchange_weak(block->_next, block, std::memory_order_release, std::memory_order_relaxed))
+				;
+		}
+
+	private:
+		// Every block is preceded by a pointer to its bin (or nullptr for large blocks).
+		// With 16-byte block strides, this leaves 16-byte aligned payloads of 16 * index + 8 bytes.
+		static constexpr size_t kHeaderSize = sizeof(void*);
+		static constexpr size_t kBinCount = (kMaxSize + 7) / 16 + 1;
+		static constexpr size_t kSlabSize = size_t{ 1 } << 16;
+
+		static_assert(kHeaderSize == 8, "Unsupported pointer size");
+
+		struct Block
+		{
+			Block* _next;
+		};
+
+		struct alignas(kCacheLineSize) Bin
+		{
+			Block* _free = nullptr;
+			uintptr_t _carve = 0;
+			uintptr_t _carveEnd = 0;
+			alignas(kCacheLineSize) std::atomic<Block*> _remote{ nullptr };
+		};
+
+		struct Cache
+		{
+			Bin _bins[kBinCount];
+			Cache* _nextOrphan = nullptr;
+		};
+
+		// Returns the thread's cache to the orphan list on thread exit.
+		struct CacheOwner
+		{
+			~CacheOwner() noexcept
+			{
+				_cacheReleased = true;
+				if (const auto cache = _cache)
+				{
+					_cache = nullptr;
+					std::scoped_lock lock{ _orphanMutex };
+					cache->_nextOrphan = _orphans;
+					_orphans = cache;
+				}
+			}
+		};
+
+		static constexpr size_t binIndex(size_t size) noexcept { return (size + 7) >> 4; }
+
+		static Cache* acquireCache()
+		{
+			Cache* cache = nullptr;
+			{
+				std::scoped_lock lock{ _orphanMutex };
+				if (_orphans)
+				{
+					cache = _orphans;
+					_orphans = cache->_nextOrphan;
+				}
+			}
+			if (!cache)
+				cache = new (AlignedAllocator<alignof(Cache)>::allocate(sizeof(Cache))) Cache;
+			static_cast<void>(_cacheOwner); // Odr-use to register the destructor.
+			_cache = cache;
+			return cache;
+		}
+
+		static void* allocateLarge(size_t size)
+		{
+			if (size > SIZE_MAX - 2 * kHeaderSize)
+				throw std::bad_alloc{};
+			const auto header = static_cast<Bin**>(Allocator::allocate(size + 2 * kHeaderSize)) + 1;
+			*header = nullptr;
+			return header + 1;
+		}
+
+		static Block* refill(Bin& bin, size_t index)
+		{
+			if (const auto remote = bin._remote.exchange(nullptr, std::memory_order_acquire))
+				return remote;
+			const auto stride = 16 * index + 16;
+			if (bin._carveEnd - bin._carve < stride)
+			{
+				// The first header is placed at offset 8 to make payloads 16-byte aligned.
+				const auto slab = reinterpret_cast<uintptr_t>(AlignedAllocator<16>::allocate(kSlabSize));
+				bin._carve = slab + kHeaderSize;
+				bin._carveEnd = slab + kSlabSize;
+			}
+			const auto header = reinterpret_cast<Bin**>(bin._carve);
+			bin._carve += stride;
+			*header = &bin;
+			const auto block = reinterpret_cast<Block*>(header + 1);
+			block->_next = nullptr;
+			return block;
+		}
+
+		static thread_local Cache* _cache;
+		static thread_local bool _cacheReleased;
+		static thread_local CacheOwner _cacheOwner;
+		static std::mutex _orphanMutex;
+		static Cache* _orphans;
+	};
+
+	inline thread_local PoolAllocator::Cache* PoolAllocator::_cache = nullptr;
+	inline thread_local bool PoolAllocator::_cacheReleased = false;
+	inline PoolAllocator::Cache* PoolAllocator::_orphans = nullptr;
+
+#ifdef __clang__
+#	pragma clang diagnostic push
+#	pragma clang diagnostic ignored "-Wexit-time-destructors"
+#	pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+	inline thread_local PoolAllocator::CacheOwner PoolAllocator::_cacheOwner;
+	inline std::mutex PoolAllocator::_orphanMutex;
+#ifdef __clang__
+#	pragma clang diagnostic pop
+#endif
+}
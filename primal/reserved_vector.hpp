@@ -0,0 +1,199 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/pointer.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#endif
+
+namespace primal
+{
+	// RigidVector-like container which reserves address space for all its elements up front
+	// and commits memory as the vector grows, so elements never move and memory usage
+	// follows the actual size instead of the reserved capacity:
+	// * is noncopyable and is able to contain immovable objects;
+	// * requires reserve() before use and allows only one reserve() during lifetime;
+	// * doesn't check preconditions at runtime (except for memory commit failures).
+	template <typename T>
+	class ReservedVector
+	{
+	public:
+		// Memory is committed and released in blocks of this size.
+		static constexpr size_t kCommitGranularity = size_t{ 1 } << 16;
+
+		static_assert(alignof(T) <= kCommitGranularity);
+
+		constexpr ReservedVector() noexcept = default;
+		ReservedVector(const ReservedVector&) = delete;
+		ReservedVector& operator=(const ReservedVector&) = delete;
+
+		constexpr ReservedVector(ReservedVector&& other) noexcept
+			: _data{ std::move(other._data) }
+			, _size{ std::exchange(other._size, size_t{}) }
+			, _committed{ std::exchange(other._committed, size_t{}) }
+		{
+		}
+
+		~ReservedVector() noexcept
+		{
+			std::destroy_n(_data.get(), _size);
+		}
+
+		constexpr ReservedVector& operator=(ReservedVector&& other) noexcept
+		{
+			swap(*this, other);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr T* begin() noexcept { return _data; }
+		[[nodiscard]] constexpr const T* begin() const noexcept { return _data; }
+		[[nodiscard]] constexpr size_t capacity() const noexcept { return _data.deleter().size() / sizeof(T); }
+		[[nodiscard]] constexpr const T* cbegin() const noexcept { return _data; }
+		[[nodiscard]] constexpr const T* cend() const noexcept { return _data + _size; }
+		[[nodiscard]] constexpr size_t committedBytes() const noexcept { return _committed; }
+		[[nodiscard]] constexpr T* data() noexcept { return _data; }
+		[[nodiscard]] constexpr const T* data() const noexcept { return _data; }
+		[[nodiscard]] constexpr bool empty() const noexcept { return !_size; }
+		[[nodiscard]] constexpr T* end() noexcept { return _data + _size; }
+		[[nodiscard]] constexpr const T* end() const noexcept { return _data + _size; }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _size; }
+
+		[[nodiscard]] constexpr T& back() noexcept
+		{
+			assert(_size > 0);
+			return _data[_size - 1];
+		}
+
+		[[nodiscard]] constexpr const T& back() const noexcept
+		{
+			assert(_size > 0);
+			return _data[_size - 1];
+		}
+
+		// Destroys all elements and optionally returns all committed memory to the system.
+		void clear(bool release = false) noexcept
+		{
+			std::destroy_n(_data.get(), _size);
+			_size = 0;
+			if (release)
+				trim();
+		}
+
+		template <typename... Args>
+		T& emplace_back(Args&&... args)
+		{
+			assert(_size < capacity());
+			if ((_size + 1) * sizeof(T) > _committed)
+				[[unlikely]]
+				commit((_size + 1) * sizeof(T));
+			T* value = new (_data + _size) T{ std::forward<Args>(args)... };
+			++_size;
+			return *value;
+		}
+
+		void pop_back() noexcept
+		{
+			assert(_size > 0);
+			--_size;
+			std::destroy_at(_data + _size);
+		}
+
+		// Reserves address space for the specified number of elements without committing any memory.
+		void reserve(size_t capacity)
+		{
+			assert(!_data);
+			if (capacity > (SIZE_MAX - kCommitGranularity) / sizeof(T))
+				throw std::bad_alloc{};
+			const auto size = (capacity * sizeof(T) + kCommitGranularity - 1) & ~(kCommitGranularity - 1);
+			if (!size)
+				return;
+#ifdef _WIN32
+			const auto memory = ::VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+			if (!memory)
+				throw std::bad_alloc{};
+#else
+			const auto memory = ::mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (memory == MAP_FAILED)
+				throw std::bad_alloc{};
+#endif
+			_data = Pointer<T, SizedFunctionDeleter<unmap>>{ static_cast<T*>(memory), size };
+		}
+
+		// Returns committed memory past the last element to the system.
+		void trim() noexcept
+		{
+			const auto required = (_size * sizeof(T) + kCommitGranularity - 1) & ~(kCommitGranularity - 1);
+			if (required >= _committed)
+				return;
+			const auto tail = reinterpret_cast<std::byte*>(_data.get()) + required;
+#ifdef _WIN32
+			if (!::VirtualFree(tail, _committed - required, MEM_DECOMMIT))
+#else
+			// Remapping discards the pages and makes the range inaccessible in a single call.
+			if (::mmap(tail, _committed - required, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED)
+#endif
+				return; // The memory stays committed.
+			_committed = required;
+		}
+
+		[[nodiscard]] T& operator[](size_t index) noexcept
+		{
+			assert(index < _size);
+			return _data[index];
+		}
+
+		[[nodiscard]] const T& operator[](size_t index) const noexcept
+		{
+			assert(index < _size);
+			return _data[index];
+		}
+
+		friend constexpr void swap(ReservedVector& first, ReservedVector& second) noexcept
+		{
+			using std::swap;
+			swap(first._data, second._data);
+			swap(first._size, second._size);
+			swap(first._committed, second._committed);
+		}
+
+	private:
+		static void unmap(T* data, [[maybe_unused]] size_t size) noexcept
+		{
+#ifdef _WIN32
+			::VirtualFree(data, 0, MEM_RELEASE);
+#else
+			::munmap(data, size);
+#endif
+		}
+
+		void commit(size_t size)
+		{
+			const auto committed = (size + kCommitGranularity - 1) & ~(kCommitGranularity - 1);
+			const auto tail = reinterpret_cast<std::byte*>(_data.get()) + _committed;
+#ifdef _WIN32
+			if (!::VirtualAlloc(tail, committed - _committed, MEM_COMMIT, PAGE_READWRITE))
+#else
+			if (::mprotect(tail, committed - _committed, PROT_READ | PROT_WRITE) == -1)
+#endif
+				throw std::bad_alloc{};
+			_committed = committed;
+		}
+
+		Pointer<T, SizedFunctionDeleter<unmap>> _data;
+		size_t _size = 0;
+		size_t _committed = 0;
+	};
+}
@@ -5,8 +5,10 @@
 #pragma once
 
 #include <primal/allocator.hpp>
+#include <primal/pointer.hpp>
 
 #include <cassert>
+#include <cstring>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -25,8 +27,11 @@ namespace primal
 		RigidVector(const RigidVector&) = delete;
 		RigidVector& operator=(const RigidVector&) = delete;
 
+		constexpr explicit RigidVector(const A& allocator) noexcept
+			: _data{ nullptr, allocator } {}
+
 		constexpr RigidVector(RigidVector&& other) noexcept
-			: _data(std::exchange(other._data, nullptr))
+			: _data(std::move(other._data))
 			, _size(std::exchange(other._size, size_t{}))
 #ifndef NDEBUG
 			, _capacity(std::exchange(other._capacity, size_t{})) // No braces in initialization because of ClangFormat bug.
@@ -36,8 +41,8 @@ namespace primal
 
 		~RigidVector() noexcept
 		{
-			std::destroy_n(_data, _size);
-			A::deallocate(_data);
+			if constexpr (!std::is_trivially_destructible_v<T>)
+				std::destroy_n(_data.get(), _size);
 		}
 
 		constexpr RigidVector& operator=(RigidVector&& other) noexcept
@@ -46,6 +51,7 @@ namespace primal
 			return *this;
 		}
 
+		[[nodiscard]] constexpr const A& allocator() const noexcept { return _data.deleter().allocator(); }
 		[[nodiscard]] constexpr T* begin() noexcept { return _data; }
 		[[nodiscard]] constexpr const T* begin() const noexcept { return _data; }
 		[[nodiscard]] constexpr const T* cbegin() const noexcept { return _data; }
@@ -69,9 +75,19 @@ namespace primal
 			return _data[_size - 1];
 		}
 
+		// Appends copies of the specified elements with a single memcpy().
+		void append(const T* data, size_t count) noexcept requires std::is_trivially_copyable_v<T>
+		{
+			assert(count <= _capacity - _size);
+			if (count > 0) // Null data is allowed if there is nothing to copy.
+				std::memcpy(_data + _size, data, count * sizeof(T));
+			_size += count;
+		}
+
 		void clear() noexcept
 		{
-			std::destroy_n(_data, _size);
+			if constexpr (!std::is_trivially_destructible_v<T>)
+				std::destroy_n(_data.get(), _size);
 			_size = 0;
 		}
 
@@ -84,6 +100,32 @@ namespace primal
 			return *value;
 		}
 
+		// Appends the specified number of elements constructed from the same arguments.
+		// Value-initialized trivial elements are zero-filled, other trivially copyable elements
+		// are copied from the first one.
+		template <typename... Args>
+		void emplace_n(size_t count, Args&&... args)
+		{
+			assert(count <= _capacity - _size);
+			if (!count)
+				return;
+			if constexpr (sizeof...(Args) == 0 && std::is_trivially_default_constructible_v<T> && std::is_trivially_copyable_v<T>)
+				std::memset(static_cast<void*>(_data + _size), 0, count * sizeof(T));
+			else if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				const auto first = new (_data + _size) T{ std::forward<Args>(args)... };
+				std::uninitialized_fill_n(first + 1, count - 1, *first);
+			}
+			else
+			{
+				// The size is updated after every element so that they are destroyed if an exception is thrown.
+				for (const auto end = _size + count; _size < end; ++_size)
+					new (_data + _size) T{ args... };
+				return;
+			}
+			_size += count;
+		}
+
 		void pop_back() noexcept
 		{
 			assert(_size > 0);
@@ -94,12 +136,19 @@ namespace primal
 		void reserve(size_t capacity)
 		{
 			assert(!_data);
-			_data = static_cast<T*>(A::allocate(capacity * sizeof(T)));
+			_data.reset(static_cast<T*>(_data.deleter().allocator().allocate(capacity * sizeof(T))));
 #ifndef NDEBUG
 			_capacity = capacity;
 #endif
 		}
 
+		// Changes the size without initializing new elements, which must be written before they are read.
+		void resize_uninitialized(size_t size) noexcept requires std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>
+		{
+			assert(size <= _capacity);
+			_size = size;
+		}
+
 		[[nodiscard]] T& operator[](size_t index) noexcept
 		{
 			assert(index < _size);
@@ -123,7 +172,7 @@ namespace primal
 		}
 
 	private:
-		T* _data = nullptr;
+		Pointer<T, AllocatorDeleter<A>> _data;
 		size_t _size = 0;
 #ifndef NDEBUG
 		size_t _capacity = 0;
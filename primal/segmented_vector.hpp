@@ -0,0 +1,260 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/allocator.hpp>
+#include <primal/pointer.hpp>
+
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace primal
+{
+	// std::vector-like container which:
+	// * is noncopyable and is able to contain immovable objects;
+	// * grows by allocating segments of doubling size and never moves its elements;
+	// * doesn't check preconditions at runtime.
+	// Segment k contains kFirstSegmentSize * 2^k elements, so an element can be located in O(1).
+	template <typename T, typename A = Allocator, size_t kFirstSegmentSize = 16>
+	class SegmentedVector
+	{
+		template <typename U>
+		class Iterator;
+
+	public:
+		static_assert(std::has_single_bit(kFirstSegmentSize));
+		static_assert(alignof(T) <= kAllocatorAlignment<A>);
+
+		using iterator = Iterator<T>;
+		using const_iterator = Iterator<const T>;
+
+		constexpr SegmentedVector() noexcept = default;
+		SegmentedVector(const SegmentedVector&) = delete;
+		SegmentedVector& operator=(const SegmentedVector&) = delete;
+
+		constexpr explicit SegmentedVector(const A& allocator) noexcept
+			: _segments{ nullptr, allocator } {}
+
+		constexpr SegmentedVector(SegmentedVector&& other) noexcept
+			: _segments{ std::move(other._segments) }
+			, _size{ std::exchange(other._size, size_t{}) }
+			, _segmentCount{ std::exchange(other._segmentCount, size_t{}) }
+		{
+		}
+
+		~SegmentedVector() noexcept
+		{
+			clear();
+			for (size_t i = 0; i < _segmentCount; ++i)
+				_segments.deleter().allocator().deallocate(_segments[i]);
+		}
+
+		constexpr SegmentedVector& operator=(SegmentedVector&& other) noexcept
+		{
+			swap(*this, other);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr const A& allocator() const noexcept { return _segments.deleter().allocator(); }
+		[[nodiscard]] constexpr iterator begin() noexcept { return _segments ? iterator{ _segments, 0, _segments[0] } : iterator{}; }
+		[[nodiscard]] constexpr const_iterator begin() const noexcept { return cbegin(); }
+		[[nodiscard]] constexpr size_t capacity() const noexcept { return kFirstSegmentSize * ((size_t{ 1 } << _segmentCount) - 1); }
+		[[nodiscard]] constexpr const_iterator cbegin() const noexcept { return _segments ? const_iterator{ _segments, 0, _segments[0] } : const_iterator{}; }
+		[[nodiscard]] constexpr const_iterator cend() const noexcept { return makeIterator<const T>(_size); }
+		[[nodiscard]] constexpr bool empty() const noexcept { return !_size; }
+		[[nodiscard]] constexpr iterator end() noexcept { return makeIterator<T>(_size); }
+		[[nodiscard]] constexpr const_iterator end() const noexcept { return cend(); }
+		[[nodiscard]] constexpr size_t segmentCount() const noexcept { return _segmentCount; }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _size; }
+
+		// Returns constructed elements of the specified segment.
+		// Iterating over segments allows processing elements in tight loops over contiguous memory.
+		[[nodiscard]] constexpr std::span<T> segment(size_t index) noexcept
+		{
+			assert(index < _segmentCount);
+			return { _segments[index], segmentElements(index) };
+		}
+
+		[[nodiscard]] constexpr std::span<const T> segment(size_t index) const noexcept
+		{
+			assert(index < _segmentCount);
+			return { _segments[index], segmentElements(index) };
+		}
+
+		[[nodiscard]] constexpr T& back() noexcept
+		{
+			assert(_size > 0);
+			return (*this)[_size - 1];
+		}
+
+		[[nodiscard]] constexpr const T& back() const noexcept
+		{
+			assert(_size > 0);
+			return (*this)[_size - 1];
+		}
+
+		// Destroys all elements, but keeps the segments allocated.
+		void clear() noexcept
+		{
+			for (size_t i = 0; i < _segmentCount; ++i)
+				std::destroy_n(_segments[i], segmentElements(i));
+			_size = 0;
+		}
+
+		template <typename... Args>
+		T& emplace_back(Args&&... args)
+		{
+			const auto [segment, offset] = locate(_size);
+			if (segment == _segmentCount)
+				allocateSegment();
+			T* value = new (_segments[segment] + offset) T{ std::forward<Args>(args)... };
+			++_size;
+			return *value;
+		}
+
+		void pop_back() noexcept
+		{
+			assert(_size > 0);
+			const auto [segment, offset] = locate(--_size);
+			std::destroy_at(_segments[segment] + offset);
+		}
+
+		// Allocates enough segments to contain the specified number of elements.
+		void reserve(size_t capacity)
+		{
+			while (this->capacity() < capacity)
+				allocateSegment();
+		}
+
+		[[nodiscard]] T& operator[](size_t index) noexcept
+		{
+			assert(index < _size);
+			const auto [segment, offset] = locate(index);
+			return _segments[segment][offset];
+		}
+
+		[[nodiscard]] const T& operator[](size_t index) const noexcept
+		{
+			assert(index < _size);
+			const auto [segment, offset] = locate(index);
+			return _segments[segment][offset];
+		}
+
+		friend constexpr void swap(SegmentedVector& first, SegmentedVector& second) noexcept
+		{
+			using std::swap;
+			swap(first._segments, second._segments);
+			swap(first._size, second._size);
+			swap(first._segmentCount, second._segmentCount);
+		}
+
+	private:
+		// The segment table has an extra null entry past the last possible segment to simplify iteration.
+		static constexpr size_t kMaxSegments = 8 * sizeof(size_t) - std::countr_zero(kFirstSegmentSize);
+
+		struct Location
+		{
+			size_t _segment;
+			size_t _offset;
+		};
+
+		template <typename U>
+		class Iterator
+		{
+		public:
+			using difference_type = ptrdiff_t;
+			using value_type = std::remove_const_t<U>;
+			using iterator_category = std::forward_iterator_tag;
+
+			constexpr Iterator() noexcept = default;
+
+			[[nodiscard]] constexpr U& operator*() const noexcept { return *_current; }
+			[[nodiscard]] constexpr U* operator->() const noexcept { return _current; }
+			[[nodiscard]] constexpr bool operator==(const Iterator& other) const noexcept { return _current == other._current; }
+
+			constexpr Iterator& operator++() noexcept
+			{
+				if (++_current == _segmentEnd)
+					enterSegment(_segment + 1, _segments[_segment + 1]);
+				return *this;
+			}
+
+			constexpr Iterator operator++(int) noexcept
+			{
+				auto result = *this;
+				++*this;
+				return result;
+			}
+
+		private:
+			T* const* _segments = nullptr;
+			size_t _segment = 0;
+			U* _current = nullptr;
+			U* _segmentEnd = nullptr;
+
+			constexpr Iterator(T* const* segments, size_t segment, U* current) noexcept
+				: _segments{ segments } { enterSegment(segment, current); }
+
+			// The segment may be unallocated if the iterator points past the last element.
+			constexpr void enterSegment(size_t segment, U* current) noexcept
+			{
+				_segment = segment;
+				_current = current;
+				_segmentEnd = _segments[segment] ? _segments[segment] + (kFirstSegmentSize << segment) : nullptr;
+			}
+
+			friend SegmentedVector;
+		};
+
+		static constexpr Location locate(size_t index) noexcept
+		{
+			const auto segment = static_cast<size_t>(std::bit_width(index / kFirstSegmentSize + 1)) - 1;
+			return { segment, index + kFirstSegmentSize - (kFirstSegmentSize << segment) };
+		}
+
+		void allocateSegment()
+		{
+			auto& allocator = _segments.deleter().allocator();
+			if (!_segments)
+			{
+				*_segments.out() = static_cast<T**>(allocator.allocate((kMaxSegments + 1) * sizeof(T*)));
+				std::memset(_segments.get(), 0, (kMaxSegments + 1) * sizeof(T*));
+			}
+			const auto elements = kFirstSegmentSize << _segmentCount;
+			if (_segmentCount == kMaxSegments || elements > SIZE_MAX / sizeof(T))
+				throw std::bad_alloc{};
+			_segments[_segmentCount] = static_cast<T*>(allocator.allocate(elements * sizeof(T)));
+			++_segmentCount;
+		}
+
+		template <typename U>
+		constexpr Iterator<U> makeIterator(size_t index) const noexcept
+		{
+			if (!_segments)
+				return {};
+			const auto [segment, offset] = locate(index);
+			return { _segments, segment, _segments[segment] + offset };
+		}
+
+		// Returns the number of constructed elements in the segment.
+		constexpr size_t segmentElements(size_t segment) const noexcept
+		{
+			const auto first = kFirstSegmentSize * ((size_t{ 1 } << segment) - 1);
+			if (_size <= first)
+				return 0;
+			const auto elements = _size - first;
+			return elements < (kFirstSegmentSize << segment) ? elements : kFirstSegmentSize << segment;
+		}
+
+		Pointer<T*, AllocatorDeleter<A>> _segments;
+		size_t _size = 0;
+		size_t _segmentCount = 0;
+	};
+}
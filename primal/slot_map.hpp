@@ -0,0 +1,280 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/allocator.hpp>
+#include <primal/buffer.hpp>
+#include <primal/pointer.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace primal
+{
+	// Container which identifies its elements by handles instead of indices or pointers:
+	// * elements are stored contiguously (and are iterated in no particular order);
+	// * insertion, erasure and lookup take constant time;
+	// * erasure moves the last element into the place of the erased one, but doesn't invalidate any handles;
+	// * a handle of an erased element never refers to another element (until its generation counter wraps around).
+	// Handles of type H (uint32_t or uint64_t) store the slot index in the low half and the generation in the high half.
+	template <typename T, typename A = Allocator, typename H = uint64_t>
+	class SlotMap
+	{
+		using Half = std::conditional_t<std::is_same_v<H, uint64_t>, uint32_t, uint16_t>;
+
+	public:
+		static_assert(std::is_same_v<H, uint32_t> || std::is_same_v<H, uint64_t>);
+		static_assert(std::is_nothrow_move_constructible_v<T>);
+
+		// The maximum number of elements.
+		static constexpr size_t kMaxSize = std::numeric_limits<Half>::max();
+
+		class Handle
+		{
+		public:
+			constexpr Handle() noexcept = default;
+
+			constexpr explicit Handle(H value) noexcept
+				: _value{ value } {}
+
+			[[nodiscard]] constexpr H value() const noexcept { return _value; }
+			[[nodiscard]] constexpr bool operator==(const Handle&) const noexcept = default;
+
+		private:
+			H _value = 0; // Generations of valid handles are odd, so a default-constructed handle is always invalid.
+
+			constexpr Handle(Half index, Half generation) noexcept
+				: _value{ static_cast<H>(H{ generation } << (sizeof(Half) * 8) | index) } {}
+
+			constexpr Half generation() const noexcept { return static_cast<Half>(_value >> (sizeof(Half) * 8)); }
+			constexpr Half index() const noexcept { return static_cast<Half>(_value); }
+
+			friend SlotMap;
+		};
+
+		constexpr SlotMap() noexcept = default;
+		SlotMap(const SlotMap&) = delete;
+		SlotMap& operator=(const SlotMap&) = delete;
+
+		constexpr explicit SlotMap(const A& allocator) noexcept
+			: _values{ nullptr, allocator }, _valueSlots{ allocator }, _slots{ allocator } {}
+
+		constexpr SlotMap(SlotMap&& other) noexcept
+			: _values{ std::move(other._values) }
+			, _valueSlots{ std::move(other._valueSlots) }
+			, _slots{ std::move(other._slots) }
+			, _size{ std::exchange(other._size, size_t{}) }
+			, _slotCount{ std::exchange(other._slotCount, size_t{}) }
+			, _capacity{ std::exchange(other._capacity, size_t{}) }
+			, _freeSlot{ std::exchange(other._freeSlot, kNoSlot) }
+		{
+		}
+
+		~SlotMap() noexcept
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>)
+				std::destroy_n(_values.get(), _size);
+		}
+
+		constexpr SlotMap& operator=(SlotMap&& other) noexcept
+		{
+			swap(*this, other);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr const A& allocator() const noexcept { return _values.deleter().allocator(); }
+		[[nodiscard]] constexpr T* begin() noexcept { return _values; }
+		[[nodiscard]] constexpr const T* begin() const noexcept { return _values; }
+		[[nodiscard]] constexpr size_t capacity() const noexcept { return _capacity; }
+		[[nodiscard]] constexpr const T* cbegin() const noexcept { return _values; }
+		[[nodiscard]] constexpr const T* cend() const noexcept { return _values + _size; }
+		[[nodiscard]] bool contains(Handle handle) const noexcept { return find(handle) != nullptr; }
+		[[nodiscard]] constexpr T* data() noexcept { return _values; }
+		[[nodiscard]] constexpr const T* data() const noexcept { return _values; }
+		[[nodiscard]] constexpr bool empty() const noexcept { return !_size; }
+		[[nodiscard]] constexpr T* end() noexcept { return _values + _size; }
+		[[nodiscard]] constexpr const T* end() const noexcept { return _values + _size; }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _size; }
+
+		// Destroys all elements and invalidates all handles, but keeps the allocated memory.
+		void clear() noexcept
+		{
+			for (size_t i = 0; i < _size; ++i)
+				releaseSlot(_valueSlots.data()[i]);
+			if constexpr (!std::is_trivially_destructible_v<T>)
+				std::destroy_n(_values.get(), _size);
+			_size = 0;
+		}
+
+		// Inserts an element constructed from the arguments and returns its handle.
+		template <typename... Args>
+		Handle emplace(Args&&... args)
+		{
+			if (_freeSlot == kNoSlot && _slotCount == _capacity)
+				[[unlikely]]
+				emplaceGrow(std::forward<Args>(args)...);
+			else
+				new (_values + _size) T{ std::forward<Args>(args)... };
+			Half index;
+			if (_freeSlot != kNoSlot)
+			{
+				index = _freeSlot;
+				_freeSlot = _slots.data()[index]._index;
+			}
+			else
+			{
+				index = static_cast<Half>(_slotCount++);
+				_slots.data()[index]._generation = 0;
+			}
+			auto& slot = _slots.data()[index];
+			slot._index = static_cast<Half>(_size);
+			++slot._generation; // Becomes odd.
+			_valueSlots.data()[_size] = index;
+			++_size;
+			return { index, slot._generation };
+		}
+
+		// Returns true if the handle referred to an element which has been erased.
+		bool erase(Handle handle) noexcept
+		{
+			const auto position = findPosition(handle);
+			if (position == _size)
+				return false;
+			--_size;
+			if (position != _size)
+			{
+				std::destroy_at(_values + position);
+				new (_values + position) T{ std::move(_values[_size]) };
+				const auto lastSlot = _valueSlots.data()[_size];
+				_valueSlots.data()[position] = lastSlot;
+				_slots.data()[lastSlot]._index = static_cast<Half>(position);
+			}
+			std::destroy_at(_values + _size);
+			releaseSlot(handle.index());
+			return true;
+		}
+
+		// Returns a pointer to the element, or nullptr if the handle is invalid.
+		[[nodiscard]] T* find(Handle handle) noexcept
+		{
+			const auto position = findPosition(handle);
+			return position != _size ? _values + position : nullptr;
+		}
+
+		[[nodiscard]] const T* find(Handle handle) const noexcept
+		{
+			const auto position = findPosition(handle);
+			return position != _size ? _values + position : nullptr;
+		}
+
+		// Returns the handle of the element with the specified position in the contiguous storage.
+		[[nodiscard]] Handle handle(size_t position) const noexcept
+		{
+			assert(position < _size);
+			const auto index = _valueSlots.data()[position];
+			return { index, _slots.data()[index]._generation };
+		}
+
+		// Makes room for the specified number of elements.
+		void reserve(size_t capacity)
+		{
+			if (capacity > _capacity)
+				relocate(allocate(capacity), capacity);
+		}
+
+		friend constexpr void swap(SlotMap& first, SlotMap& second) noexcept
+		{
+			using std::swap;
+			swap(first._values, second._values);
+			swap(first._valueSlots, second._valueSlots);
+			swap(first._slots, second._slots);
+			swap(first._size, second._size);
+			swap(first._slotCount, second._slotCount);
+			swap(first._capacity, second._capacity);
+			swap(first._freeSlot, second._freeSlot);
+		}
+
+	private:
+		static constexpr Half kNoSlot = std::numeric_limits<Half>::max();
+
+		struct Slot
+		{
+			Half _index; // Position of the element if the slot is used, or the next free slot.
+			Half _generation; // Odd if the slot is used.
+		};
+
+		// Allocates storage for values and grows the slot buffers to the specified capacity.
+		Pointer<T, AllocatorDeleter<A>> allocate(size_t capacity)
+		{
+			if (capacity > kMaxSize)
+				throw std::bad_alloc{};
+			auto& allocator = _values.deleter().allocator();
+			Pointer<T, AllocatorDeleter<A>> values{ static_cast<T*>(allocator.allocate(capacity * sizeof(T))), allocator };
+			_slots.reserve(capacity);
+			_valueSlots.reserve(capacity);
+			return values;
+		}
+
+		// The new element is constructed before relocation because the arguments may refer to existing elements.
+		template <typename... Args>
+		void emplaceGrow(Args&&... args)
+		{
+			if (_capacity == kMaxSize) // Index kMaxSize is reserved for kNoSlot.
+				throw std::bad_alloc{};
+			const auto capacity = _capacity ? (_capacity < kMaxSize / 2 ? _capacity * 2 : kMaxSize) : 16;
+			auto values = allocate(capacity);
+			new (values + _size) T{ std::forward<Args>(args)... };
+			relocate(std::move(values), capacity);
+		}
+
+		// Returns the size if the handle is invalid.
+		size_t findPosition(Handle handle) const noexcept
+		{
+			const auto index = handle.index();
+			if (index >= _slotCount)
+				return _size;
+			const auto& slot = _slots.data()[index];
+			return slot._generation == handle.generation() && (slot._generation & 1) ? slot._index : _size;
+		}
+
+		void relocate(Pointer<T, AllocatorDeleter<A>> values, size_t capacity) noexcept
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				if (_size)
+					std::memcpy(static_cast<void*>(values.get()), _values.get(), _size * sizeof(T));
+			}
+			else
+			{
+				std::uninitialized_move_n(_values.get(), _size, values.get());
+				std::destroy_n(_values.get(), _size);
+			}
+			swap(_values, values);
+			_capacity = capacity;
+		}
+
+		void releaseSlot(Half index) noexcept
+		{
+			auto& slot = _slots.data()[index];
+			++slot._generation; // Becomes even.
+			slot._index = _freeSlot;
+			_freeSlot = index;
+		}
+
+		Pointer<T, AllocatorDeleter<A>> _values;
+		Buffer<Half, A> _valueSlots; // Slot index for every element.
+		Buffer<Slot, A> _slots;
+		size_t _size = 0;
+		size_t _slotCount = 0;
+		size_t _capacity = 0;
+		Half _freeSlot = kNoSlot;
+	};
+}
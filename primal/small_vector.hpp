@@ -0,0 +1,168 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/allocator.hpp>
+#include <primal/pointer.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace primal
+{
+	// std::vector-like container which keeps up to kInline elements inside the object
+	// and moves them to memory obtained from the allocator when it grows larger.
+	template <typename T, size_t kInline, typename A = Allocator, size_t kAlignment = alignof(T)>
+	class SmallVector
+	{
+	public:
+		static_assert(kInline > 0);
+		static_assert(kAlignment <= kAllocatorAlignment<A>);
+		static_assert(std::is_nothrow_move_constructible_v<T>);
+
+		SmallVector() noexcept = default;
+		SmallVector(const SmallVector&) = delete;
+		SmallVector& operator=(const SmallVector&) = delete;
+
+		~SmallVector() noexcept
+		{
+			clear();
+			if (_data != inlineData())
+				A::deallocate(_data);
+		}
+
+		SmallVector(std::initializer_list<T> initializers)
+			: SmallVector{} // Makes the destructor free the memory if a copy throws.
+		{
+			reserve(initializers.size());
+			std::uninitialized_copy_n(initializers.begin(), initializers.size(), _data);
+			_size = initializers.size();
+		}
+
+		[[nodiscard]] constexpr T* begin() noexcept { return _data; }
+		[[nodiscard]] constexpr const T* begin() const noexcept { return _data; }
+		[[nodiscard]] constexpr size_t capacity() const noexcept { return _capacity; }
+		[[nodiscard]] constexpr const T* cbegin() const noexcept { return _data; }
+		[[nodiscard]] constexpr const T* cend() const noexcept { return _data + _size; }
+		[[nodiscard]] constexpr T* data() noexcept { return _data; }
+		[[nodiscard]] constexpr const T* data() const noexcept { return _data; }
+		[[nodiscard]] constexpr bool empty() const noexcept { return !_size; }
+		[[nodiscard]] constexpr T* end() noexcept { return _data + _size; }
+		[[nodiscard]] constexpr const T* end() const noexcept { return _data + _size; }
+		[[nodiscard]] constexpr bool isInline() const noexcept { return _data == inlineData(); }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _size; }
+
+		[[nodiscard]] constexpr T& back() noexcept
+		{
+			assert(_size > 0);
+			return _data[_size - 1];
+		}
+
+		[[nodiscard]] constexpr const T& back() const noexcept
+		{
+			assert(_size > 0);
+			return _data[_size - 1];
+		}
+
+		// Destroys all elements, but keeps the allocated memory.
+		void clear() noexcept
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>)
+				std::destroy_n(_data, _size);
+			_size = 0;
+		}
+
+		template <typename... Args>
+		T& emplace_back(Args&&... args)
+		{
+			if (_size == _capacity)
+				[[unlikely]]
+				return emplaceGrow(std::forward<Args>(args)...);
+			T* value = new (_data + _size) T{ std::forward<Args>(args)... };
+			++_size;
+			return *value;
+		}
+
+		void pop_back() noexcept
+		{
+			assert(_size > 0);
+			--_size;
+			std::destroy_at(_data + _size);
+		}
+
+		void reserve(size_t capacity)
+		{
+			if (capacity > _capacity)
+				relocate(allocate(capacity), capacity);
+		}
+
+		[[nodiscard]] T& operator[](size_t index) noexcept
+		{
+			assert(index < _size);
+			return _data[index];
+		}
+
+		[[nodiscard]] const T& operator[](size_t index) const noexcept
+		{
+			assert(index < _size);
+			return _data[index];
+		}
+
+	private:
+		static T* allocate(size_t capacity)
+		{
+			if (capacity > SIZE_MAX / sizeof(T))
+				throw std::bad_alloc{};
+			return static_cast<T*>(A::allocate(capacity * sizeof(T)));
+		}
+
+		// The new element is constructed before relocation because the arguments may refer to existing elements.
+		template <typename... Args>
+		T& emplaceGrow(Args&&... args)
+		{
+			const auto capacity = _capacity * 2 > _capacity ? _capacity * 2 : SIZE_MAX;
+			const auto data = allocate(capacity);
+			T* value;
+			if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+				value = new (data + _size) T{ std::forward<Args>(args)... };
+			else
+			{
+				Pointer<T, AllocatorDeleter<A>> guard{ data }; // Frees the memory if the constructor throws.
+				value = new (data + _size) T{ std::forward<Args>(args)... };
+				*guard.out() = nullptr;
+			}
+			relocate(data, capacity);
+			++_size;
+			return *value;
+		}
+
+		constexpr const T* inlineData() const noexcept { return reinterpret_cast<const T*>(_inline); }
+		constexpr T* inlineData() noexcept { return reinterpret_cast<T*>(_inline); }
+
+		void relocate(T* data, size_t capacity) noexcept
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+				std::memcpy(static_cast<void*>(data), _data, _size * sizeof(T));
+			else
+			{
+				std::uninitialized_move_n(_data, _size, data);
+				std::destroy_n(_data, _size);
+			}
+			if (_data != inlineData())
+				A::deallocate(_data);
+			_data = data;
+			_capacity = capacity;
+		}
+
+		T* _data = inlineData();
+		size_t _size = 0;
+		size_t _capacity = kInline;
+		alignas(kAlignment) std::aligned_storage_t<sizeof(T), alignof(T)> _inline[kInline];
+	};
+}
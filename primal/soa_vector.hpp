@@ -0,0 +1,226 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/allocator.hpp>
+#include <primal/dsp.hpp>
+#include <primal/pointer.hpp>
+
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace primal
+{
+	// Structure-of-arrays container which stores each field in a separate column:
+	// * requires reserve() before use and allows only one reserve() during lifetime;
+	// * aligns each column to at least kDspAlignment, so columns can be passed to DSP functions;
+	// * requires field construction to be nothrow;
+	// * doesn't check preconditions at runtime.
+	template <typename... Ts>
+	class SoaVector
+	{
+		template <typename... Us>
+		class Iterator;
+
+	public:
+		static_assert(sizeof...(Ts) > 0);
+
+		using iterator = Iterator<Ts...>;
+		using const_iterator = Iterator<const Ts...>;
+
+		constexpr SoaVector() noexcept = default;
+		SoaVector(const SoaVector&) = delete;
+		SoaVector& operator=(const SoaVector&) = delete;
+
+		constexpr SoaVector(SoaVector&& other) noexcept
+			: _columns(std::move(other._columns))
+			, _size(std::exchange(other._size, size_t{}))
+#ifndef NDEBUG
+			, _capacity(std::exchange(other._capacity, size_t{})) // No braces in initialization because of ClangFormat bug.
+#endif
+		{
+		}
+
+		~SoaVector() noexcept
+		{
+			clear();
+		}
+
+		constexpr SoaVector& operator=(SoaVector&& other) noexcept
+		{
+			swap(*this, other);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr iterator begin() noexcept { return iterator{ pointers(0) }; }
+		[[nodiscard]] constexpr const_iterator begin() const noexcept { return const_iterator{ pointers(0) }; }
+		[[nodiscard]] constexpr const_iterator cbegin() const noexcept { return const_iterator{ pointers(0) }; }
+		[[nodiscard]] constexpr const_iterator cend() const noexcept { return const_iterator{ pointers(_size) }; }
+		[[nodiscard]] constexpr bool empty() const noexcept { return !_size; }
+		[[nodiscard]] constexpr iterator end() noexcept { return iterator{ pointers(_size) }; }
+		[[nodiscard]] constexpr const_iterator end() const noexcept { return const_iterator{ pointers(_size) }; }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _size; }
+
+		template <size_t kIndex>
+		[[nodiscard]] constexpr std::span<std::tuple_element_t<kIndex, std::tuple<Ts...>>> column() noexcept
+		{
+			return { std::get<kIndex>(_columns).get(), _size };
+		}
+
+		template <size_t kIndex>
+		[[nodiscard]] constexpr std::span<const std::tuple_element_t<kIndex, std::tuple<Ts...>>> column() const noexcept
+		{
+			return { std::get<kIndex>(_columns).get(), _size };
+		}
+
+		[[nodiscard]] constexpr std::tuple<Ts&...> back() noexcept
+		{
+			assert(_size > 0);
+			return (*this)[_size - 1];
+		}
+
+		[[nodiscard]] constexpr std::tuple<const Ts&...> back() const noexcept
+		{
+			assert(_size > 0);
+			return (*this)[_size - 1];
+		}
+
+		void clear() noexcept
+		{
+			std::apply([this](auto&... columns) { (destroyColumn(columns.get(), 0, _size), ...); }, _columns);
+			_size = 0;
+		}
+
+		// Appends an element with every field constructed from the corresponding argument.
+		template <typename... Args>
+		std::tuple<Ts&...> emplace_back(Args&&... args) requires(sizeof...(Args) == sizeof...(Ts))
+		{
+			assert(_size < _capacity);
+			emplaceFields(std::index_sequence_for<Ts...>{}, std::forward<Args>(args)...);
+			return (*this)[_size++];
+		}
+
+		void pop_back() noexcept
+		{
+			assert(_size > 0);
+			--_size;
+			std::apply([this](auto&... columns) { (destroyColumn(columns.get(), _size, _size + 1), ...); }, _columns);
+		}
+
+		void reserve(size_t capacity)
+		{
+			assert(!std::get<0>(_columns));
+			reserveColumns(capacity, std::index_sequence_for<Ts...>{});
+#ifndef NDEBUG
+			_capacity = capacity;
+#endif
+		}
+
+		[[nodiscard]] std::tuple<Ts&...> operator[](size_t index) noexcept
+		{
+			assert(index < _size);
+			return std::apply([index](auto&... columns) { return std::tuple<Ts&...>{ columns[index]... }; }, _columns);
+		}
+
+		[[nodiscard]] std::tuple<const Ts&...> operator[](size_t index) const noexcept
+		{
+			assert(index < _size);
+			return std::apply([index](const auto&... columns) { return std::tuple<const Ts&...>{ columns[index]... }; }, _columns);
+		}
+
+		friend constexpr void swap(SoaVector& first, SoaVector& second) noexcept
+		{
+			using std::swap;
+			swap(first._columns, second._columns);
+			swap(first._size, second._size);
+#ifndef NDEBUG
+			swap(first._capacity, second._capacity);
+#endif
+		}
+
+	private:
+		template <typename T>
+		static constexpr size_t kColumnAlignment = alignof(T) > kDspAlignment ? alignof(T) : kDspAlignment;
+
+		template <typename T>
+		using Column = Pointer<T, AllocatorDeleter<AlignedAllocator<kColumnAlignment<T>>>>;
+
+		// Zipped iterator which dereferences to a tuple of references to the element fields.
+		template <typename... Us>
+		class Iterator
+		{
+		public:
+			using difference_type = ptrdiff_t;
+			using value_type = std::tuple<Us&...>;
+			using iterator_category = std::forward_iterator_tag;
+
+			constexpr Iterator() noexcept = default;
+
+			[[nodiscard]] constexpr std::tuple<Us&...> operator*() const noexcept
+			{
+				return std::apply([](auto... pointers) { return std::tuple<Us&...>{ *pointers... }; }, _pointers);
+			}
+
+			[[nodiscard]] constexpr bool operator==(const Iterator& other) const noexcept { return std::get<0>(_pointers) == std::get<0>(other._pointers); }
+
+			constexpr Iterator& operator++() noexcept
+			{
+				std::apply([](auto&... pointers) { (++pointers, ...); }, _pointers);
+				return *this;
+			}
+
+			constexpr Iterator operator++(int) noexcept
+			{
+				auto result = *this;
+				++*this;
+				return result;
+			}
+
+		private:
+			std::tuple<Us*...> _pointers;
+
+			constexpr explicit Iterator(const std::tuple<Us*...>& pointers) noexcept
+				: _pointers{ pointers } {}
+
+			friend SoaVector;
+		};
+
+		template <typename T>
+		static void destroyColumn(T* data, size_t first, size_t last) noexcept
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>)
+				std::destroy(data + first, data + last);
+		}
+
+		template <size_t... kIndices, typename... Args>
+		void emplaceFields(std::index_sequence<kIndices...>, Args&&... args)
+		{
+			static_assert((std::is_nothrow_constructible_v<Ts, Args&&> && ...), "Field construction must not throw");
+			(new (std::get<kIndices>(_columns) + _size) Ts{ std::forward<Args>(args) }, ...);
+		}
+
+		constexpr std::tuple<Ts*...> pointers(size_t index) const noexcept
+		{
+			return std::apply([index](const auto&... columns) { return std::tuple<Ts*...>{ columns ? columns + index : nullptr... }; }, _columns);
+		}
+
+		template <size_t... kIndices>
+		void reserveColumns(size_t capacity, std::index_sequence<kIndices...>)
+		{
+			(std::get<kIndices>(_columns).reset(static_cast<Ts*>(AlignedAllocator<kColumnAlignment<Ts>>::allocate(capacity * sizeof(Ts)))), ...);
+		}
+
+		std::tuple<Column<Ts>...> _columns;
+		size_t _size = 0;
+#ifndef NDEBUG
+		size_t _capacity = 0;
+#endif
+	};
+}
@@ -0,0 +1,128 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/buffer.hpp>
+#include <primal/cache_line.hpp>
+#include <primal/dsp.hpp>
+
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <span>
+
+namespace primal
+{
+	// Lock-free ring buffer for a single producer thread and a single consumer thread.
+	// Contiguous regions returned by writable() and readable() are kDspAlignment-aligned
+	// as long as all commits are multiples of kGranularity, so DSP functions can work
+	// on ring memory directly.
+	template <typename T>
+	class SpscRing
+	{
+	public:
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		static constexpr size_t kGranularity = kDspAlignment > sizeof(T) ? kDspAlignment / sizeof(T) : 1;
+
+		// The capacity is rounded up to a power of two.
+		explicit SpscRing(size_t capacity)
+			: _buffer{ std::bit_ceil(capacity > kGranularity ? capacity : kGranularity) }
+			, _mask{ _buffer.capacity() - 1 }
+		{
+		}
+
+		[[nodiscard]] constexpr size_t capacity() const noexcept { return _buffer.capacity(); }
+
+		// Producer: returns the largest free region which starts at the write position.
+		[[nodiscard]] std::span<T> writable() noexcept
+		{
+			const auto tail = _tail.load(std::memory_order_relaxed);
+			const auto offset = tail & _mask;
+			const auto contiguous = _buffer.capacity() - offset;
+			if (_buffer.capacity() - (tail - _producerHead) < contiguous)
+				_producerHead = _head.load(std::memory_order_acquire);
+			const auto free = _buffer.capacity() - (tail - _producerHead);
+			return { _buffer.data() + offset, free < contiguous ? free : contiguous };
+		}
+
+		// Producer: makes the specified number of elements at the start of writable() available to the consumer.
+		void commitWrite(size_t count) noexcept
+		{
+			const auto tail = _tail.load(std::memory_order_relaxed);
+			assert(count <= _buffer.capacity() - (tail - _producerHead));
+			_tail.store(tail + count, std::memory_order_release);
+		}
+
+		// Producer: copies as many elements as there is free space for, returns the number of elements copied.
+		size_t write(std::span<const T> data) noexcept
+		{
+			size_t written = 0;
+			for (int i = 0; i < 2 && written < data.size(); ++i) // The free space may wrap around once.
+			{
+				const auto region = writable();
+				const auto count = region.size() < data.size() - written ? region.size() : data.size() - written;
+				if (!count)
+					break;
+				std::memcpy(region.data(), data.data() + written, count * sizeof(T));
+				commitWrite(count);
+				written += count;
+			}
+			return written;
+		}
+
+		// Consumer: returns the largest filled region which starts at the read position.
+		[[nodiscard]] std::span<const T> readable() noexcept
+		{
+			const auto head = _head.load(std::memory_order_relaxed);
+			const auto offset = head & _mask;
+			const auto contiguous = _buffer.capacity() - offset;
+			if (_consumerTail - head < contiguous)
+				_consumerTail = _tail.load(std::memory_order_acquire);
+			const auto filled = _consumerTail - head;
+			return { _buffer.data() + offset, filled < contiguous ? filled : contiguous };
+		}
+
+		// Consumer: releases the specified number of elements at the start of readable() to the producer.
+		void commitRead(size_t count) noexcept
+		{
+			const auto head = _head.load(std::memory_order_relaxed);
+			assert(count <= _consumerTail - head);
+			_head.store(head + count, std::memory_order_release);
+		}
+
+		// Consumer: copies as many elements as are available, returns the number of elements copied.
+		size_t read(std::span<T> data) noexcept
+		{
+			size_t read = 0;
+			for (int i = 0; i < 2 && read < data.size(); ++i) // The filled space may wrap around once.
+			{
+				const auto region = readable();
+				const auto count = region.size() < data.size() - read ? region.size() : data.size() - read;
+				if (!count)
+					break;
+				std::memcpy(data.data() + read, region.data(), count * sizeof(T));
+				commitRead(count);
+				read += count;
+			}
+			return read;
+		}
+
+	private:
+
+		// Shared read-only state.
+		Buffer<T, AlignedAllocator<kDspAlignment>> _buffer;
+		const size_t _mask;
+
+		// Producer state.
+		alignas(kCacheLineSize) std::atomic<size_t> _tail{ 0 };
+		size_t _producerHead = 0; // Last known consumer position.
+
+		// Consumer state.
+		alignas(kCacheLineSize) std::atomic<size_t> _head{ 0 };
+		size_t _consumerTail = 0; // Last known producer position.
+	};
+}
@@ -0,0 +1,203 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace primal
+{
+	// Hash map with preallocated storage for up to kCapacity elements (like StaticVector).
+	// Uses linear probing over a power-of-two number of slots with backward shift deletion,
+	// so there are no tombstones. Doesn't check preconditions at runtime.
+	template <typename K, typename V, size_t kCapacity, typename Hash = std::hash<K>>
+	class StaticHashMap
+	{
+		struct Slot;
+		template <typename S, typename KeyRef, typename ValueRef>
+		class Iterator;
+
+	public:
+		static_assert(std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>);
+
+		// The table is kept at most 80% full.
+		static constexpr size_t kSlotCount = std::bit_ceil(kCapacity + kCapacity / 4 + 1);
+
+		using iterator = Iterator<Slot, const K&, V&>;
+		using const_iterator = Iterator<const Slot, const K&, const V&>;
+
+		constexpr StaticHashMap() noexcept = default;
+		StaticHashMap(const StaticHashMap&) = delete;
+		~StaticHashMap() noexcept { clear(); }
+		StaticHashMap& operator=(const StaticHashMap&) = delete;
+
+		[[nodiscard]] iterator begin() noexcept { return { _tags, slots(), _tags + kSlotCount }; }
+		[[nodiscard]] const_iterator begin() const noexcept { return { _tags, slots(), _tags + kSlotCount }; }
+		[[nodiscard]] bool contains(const K& key) const noexcept { return find(key) != nullptr; }
+		[[nodiscard]] constexpr bool empty() const noexcept { return !_size; }
+		[[nodiscard]] iterator end() noexcept { return { _tags + kSlotCount, slots() + kSlotCount, _tags + kSlotCount }; }
+		[[nodiscard]] const_iterator end() const noexcept { return { _tags + kSlotCount, slots() + kSlotCount, _tags + kSlotCount }; }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _size; }
+
+		void clear() noexcept
+		{
+			for (size_t i = 0; i < kSlotCount; ++i)
+			{
+				if constexpr (!std::is_trivially_destructible_v<Slot>)
+					if (_tags[i])
+						std::destroy_at(slots() + i);
+				_tags[i] = 0;
+			}
+			_size = 0;
+		}
+
+		// Returns true if the key was found and erased.
+		bool erase(const K& key) noexcept
+		{
+			auto index = findIndex(key);
+			if (index == kSlotCount)
+				return false;
+			std::destroy_at(slots() + index);
+			// Move back the following elements which would become unreachable otherwise.
+			for (auto next = (index + 1) & kMask; _tags[next]; next = (next + 1) & kMask)
+			{
+				const auto home = static_cast<size_t>(hashOf(slots()[next]._key)) & kMask;
+				if (((next - home) & kMask) < ((next - index) & kMask))
+					continue;
+				new (slots() + index) Slot{ std::move(slots()[next]) };
+				std::destroy_at(slots() + next);
+				_tags[index] = _tags[next];
+				index = next;
+			}
+			_tags[index] = 0;
+			--_size;
+			return true;
+		}
+
+		// Returns a pointer to the value, or nullptr if there is no such key.
+		[[nodiscard]] V* find(const K& key) noexcept
+		{
+			const auto index = findIndex(key);
+			return index != kSlotCount ? &slots()[index]._value : nullptr;
+		}
+
+		[[nodiscard]] const V* find(const K& key) const noexcept
+		{
+			const auto index = findIndex(key);
+			return index != kSlotCount ? &slots()[index]._value : nullptr;
+		}
+
+		// Inserts a value constructed from the arguments if there is no such key.
+		// Returns a pointer to the value with the key and whether it was inserted.
+		template <typename Key, typename... Args>
+		std::pair<V*, bool> try_emplace(Key&& key, Args&&... args) requires std::is_same_v<std::remove_cvref_t<Key>, K>
+		{
+			const auto hash = hashOf(key);
+			const auto tag = tagOf(hash);
+			auto index = static_cast<size_t>(hash) & kMask;
+			for (; _tags[index]; index = (index + 1) & kMask)
+				if (_tags[index] == tag && slots()[index]._key == key)
+					return { &slots()[index]._value, false };
+			assert(_size < kCapacity);
+			const auto slot = new (slots() + index) Slot{ std::forward<Key>(key), V{ std::forward<Args>(args)... } };
+			_tags[index] = tag;
+			++_size;
+			return { &slot->_value, true };
+		}
+
+		V& operator[](const K& key) requires std::is_default_constructible_v<V>
+		{
+			return *try_emplace(key).first;
+		}
+
+	private:
+		static constexpr size_t kMask = kSlotCount - 1;
+
+		struct Slot
+		{
+			K _key;
+			V _value;
+		};
+
+		template <typename S, typename KeyRef, typename ValueRef>
+		class Iterator
+		{
+		public:
+			using difference_type = ptrdiff_t;
+			using value_type = std::pair<KeyRef, ValueRef>;
+			using iterator_category = std::forward_iterator_tag;
+
+			constexpr Iterator() noexcept = default;
+
+			[[nodiscard]] constexpr std::pair<KeyRef, ValueRef> operator*() const noexcept { return { _slot->_key, _slot->_value }; }
+			[[nodiscard]] constexpr bool operator==(const Iterator& other) const noexcept { return _slot == other._slot; }
+
+			constexpr Iterator& operator++() noexcept
+			{
+				++_tag;
+				++_slot;
+				skipEmpty();
+				return *this;
+			}
+
+			constexpr Iterator operator++(int) noexcept
+			{
+				auto result = *this;
+				++*this;
+				return result;
+			}
+
+		private:
+			const uint8_t* _tag = nullptr;
+			S* _slot = nullptr;
+			const uint8_t* _end = nullptr;
+
+			constexpr Iterator(const uint8_t* tag, S* slot, const uint8_t* end) noexcept
+				: _tag{ tag }, _slot{ slot }, _end{ end } { skipEmpty(); }
+
+			constexpr void skipEmpty() noexcept
+			{
+				for (; _tag != _end && !*_tag; ++_tag)
+					++_slot;
+			}
+
+			friend StaticHashMap;
+		};
+
+		// The hash is mixed so that both the home slot and the tag depend on all input bits.
+		static uint64_t hashOf(const K& key) noexcept
+		{
+			const auto hash = static_cast<uint64_t>(Hash{}(key)) * 0x9e3779b97f4a7c15;
+			return hash ^ (hash >> 32);
+		}
+
+		// Nonzero tags mark occupied slots and filter out most key comparisons.
+		static constexpr uint8_t tagOf(uint64_t hash) noexcept { return static_cast<uint8_t>(0x80 | (hash >> 57)); }
+
+		size_t findIndex(const K& key) const noexcept
+		{
+			const auto hash = hashOf(key);
+			const auto tag = tagOf(hash);
+			for (auto index = static_cast<size_t>(hash) & kMask; _tags[index]; index = (index + 1) & kMask)
+				if (_tags[index] == tag && slots()[index]._key == key)
+					return index;
+			return kSlotCount;
+		}
+
+		Slot* slots() noexcept { return reinterpret_cast<Slot*>(_slots); }
+		const Slot* slots() const noexcept { return reinterpret_cast<const Slot*>(_slots); }
+
+		size_t _size = 0;
+		uint8_t _tags[kSlotCount]{};
+		std::aligned_storage_t<sizeof(Slot), alignof(Slot)> _slots[kSlotCount];
+	};
+}
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <type_traits>
@@ -24,7 +25,7 @@ namespace primal
 		StaticVector(std::initializer_list<T> initializers) noexcept
 			: _size{ initializers.size() <= kCapacity ? initializers.size() : kCapacity }
 		{
-			std::uninitialized_copy_n(initializers.begin(), _size, _data);
+			std::uninitialized_copy_n(initializers.begin(), _size, reinterpret_cast<T*>(_data));
 		}
 
 		[[nodiscard]] constexpr T* begin() noexcept { return reinterpret_cast<T*>(_data); }
@@ -88,4 +89,84 @@ namespace primal
 		size_t _size = 0;
 		alignas(kAlignment) std::aligned_storage_t<sizeof(T), alignof(T)> _data[kCapacity];
 	};
+
+	// StaticVector specialization for trivial types which is itself trivially copyable
+	// (and therefore copyable) and usable in constant expressions. Unused elements are left
+	// uninitialized except during constant evaluation, so construction doesn't touch the storage.
+	template <typename T, size_t kCapacity, size_t kAlignment>
+	requires(std::is_trivially_copyable_v<T> && std::is_trivially_default_constructible_v<T>)
+	class StaticVector<T, kCapacity, kAlignment>
+	{
+	public:
+		constexpr StaticVector() noexcept
+		{
+			if (std::is_constant_evaluated())
+				std::fill_n(_data, kCapacity, T{}); // Constant expressions can't contain uninitialized values.
+		}
+
+		constexpr StaticVector(std::initializer_list<T> initializers) noexcept
+			: _size{ initializers.size() <= kCapacity ? initializers.size() : kCapacity }
+		{
+			std::copy_n(initializers.begin(), _size, _data);
+			if (std::is_constant_evaluated())
+				std::fill(_data + _size, _data + kCapacity, T{});
+		}
+
+		[[nodiscard]] constexpr T* begin() noexcept { return _data; }
+		[[nodiscard]] constexpr const T* begin() const noexcept { return _data; }
+		[[nodiscard]] constexpr const T* cbegin() const noexcept { return _data; }
+		[[nodiscard]] constexpr const T* cend() const noexcept { return _data + _size; }
+		[[nodiscard]] constexpr T* data() noexcept { return _data; }
+		[[nodiscard]] constexpr const T* data() const noexcept { return _data; }
+		[[nodiscard]] constexpr bool empty() const noexcept { return !_size; }
+		[[nodiscard]] constexpr T* end() noexcept { return _data + _size; }
+		[[nodiscard]] constexpr const T* end() const noexcept { return _data + _size; }
+		[[nodiscard]] constexpr size_t size() const noexcept { return _size; }
+
+		[[nodiscard]] constexpr T& back() noexcept
+		{
+			assert(_size > 0);
+			return _data[_size - 1];
+		}
+
+		[[nodiscard]] constexpr const T& back() const noexcept
+		{
+			assert(_size > 0);
+			return _data[_size - 1];
+		}
+
+		constexpr void clear() noexcept
+		{
+			_size = 0;
+		}
+
+		template <typename... Args>
+		constexpr T& emplace_back(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>)
+		{
+			assert(_size < kCapacity);
+			return _data[_size++] = T{ std::forward<Args>(args)... };
+		}
+
+		constexpr void pop_back() noexcept
+		{
+			assert(_size > 0);
+			--_size;
+		}
+
+		[[nodiscard]] constexpr T& operator[](size_t index) noexcept
+		{
+			assert(index < _size);
+			return _data[index];
+		}
+
+		[[nodiscard]] constexpr const T& operator[](size_t index) const noexcept
+		{
+			assert(index < _size);
+			return _data[index];
+		}
+
+	private:
+		size_t _size = 0;
+		alignas(kAlignment) T _data[kCapacity];
+	};
 }
@@ -0,0 +1,40 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace primal
+{
+	// Pointer with a version tag packed into a single 64-bit value, so both can be updated with a single CAS
+	// (a double-width one on 32-bit platforms) to detect that the pointer has been changed and changed back (ABA).
+	// On 64-bit platforms the tag occupies the high 16 bits, which are unused in user space addresses.
+	template <typename T>
+	class TaggedPointer
+	{
+	public:
+		static constexpr unsigned kTagBits = sizeof(void*) == 8 ? 16 : 32;
+
+		constexpr TaggedPointer() noexcept = default;
+
+		TaggedPointer(T* pointer, uint32_t tag) noexcept
+			: _value{ static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer)) | uint64_t{ tag } << kPointerBits }
+		{
+			assert(!(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer)) >> kPointerBits));
+		}
+
+		[[nodiscard]] constexpr bool operator==(const TaggedPointer&) const noexcept = default;
+
+		[[nodiscard]] T* pointer() const noexcept { return reinterpret_cast<T*>(static_cast<uintptr_t>(_value & kPointerMask)); }
+		[[nodiscard]] constexpr uint32_t tag() const noexcept { return static_cast<uint32_t>(_value >> kPointerBits); }
+
+	private:
+		static constexpr unsigned kPointerBits = 64 - kTagBits;
+		static constexpr uint64_t kPointerMask = (uint64_t{ 1 } << kPointerBits) - 1;
+
+		uint64_t _value = 0;
+	};
+}
@@ -0,0 +1,372 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/cache_line.hpp>
+#include <primal/intrusive_stack.hpp>
+#include <primal/mpmc_queue.hpp>
+#include <primal/rigid_vector.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace primal
+{
+	class TaskGroup;
+
+	// Work-stealing thread pool:
+	// * every worker has a Chase-Lev deque, pushes and pops its own tasks at the bottom
+	//   and steals tasks of other workers from the top when it runs out of them;
+	// * tasks submitted by other threads go to a shared bounded queue;
+	// * tasks are executed inline if the deque (or the queue) is full;
+	// * task objects are reused, so submitting a task doesn't allocate memory after warm-up;
+	// * tasks must not throw exceptions;
+	// * threads waiting for a TaskGroup execute tasks too, so the pool may have no workers at all.
+	class ThreadPool
+	{
+	public:
+		explicit ThreadPool(size_t workerCount)
+		{
+			_workers.reserve(workerCount);
+			for (size_t i = 0; i < workerCount; ++i)
+				_workers.emplace_back(*this);
+			try
+			{
+				for (auto& worker : _workers)
+					worker._thread = std::thread{ [this, &worker] { run(worker); } };
+			}
+			catch (...)
+			{
+				stop();
+				throw;
+			}
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// All task groups must be waited for before the pool is destroyed.
+		~ThreadPool() noexcept
+		{
+			stop();
+			for (auto task = _freeTasks.popAll(); task;)
+				delete std::exchange(task, static_cast<Task*>(task->_next.load(std::memory_order_relaxed)));
+		}
+
+		[[nodiscard]] size_t workerCount() const noexcept { return _workers.size(); }
+
+		// Calls the function for nonempty subranges of [begin, end) no longer than the grain size, possibly in parallel,
+		// and returns when all calls have finished. All subranges except the last one start at multiples of the grain size from the beginning.
+		template <typename F>
+		void parallel_for(size_t begin, size_t end, size_t grain, const F& function);
+
+	private:
+		static constexpr size_t kDequeCapacity = 1024;
+		static constexpr size_t kQueueCapacity = 1024;
+		static constexpr int kSpinCount = 64;
+
+		// Type-erased callable with inline storage.
+		class Task : public IntrusiveNode
+		{
+		public:
+			static constexpr size_t kStorageSize = 48;
+
+			template <typename F>
+			void set(F&& function, TaskGroup& group) noexcept
+			{
+				using Function = std::remove_cvref_t<F>;
+				static_assert(sizeof(Function) <= kStorageSize && alignof(Function) <= alignof(std::max_align_t), "The function is too large for a task");
+				static_assert(std::is_nothrow_constructible_v<Function, F&&>);
+				new (_storage) Function{ std::forward<F>(function) };
+				_invoke = [](Task& task) noexcept {
+					auto& stored = *std::launder(reinterpret_cast<Function*>(task._storage));
+					stored();
+					std::destroy_at(&stored);
+				};
+				_group = &group;
+			}
+
+			void run() noexcept;
+
+		private:
+			void (*_invoke)(Task&) noexcept = nullptr;
+			TaskGroup* _group = nullptr;
+			alignas(std::max_align_t) std::byte _storage[kStorageSize];
+		};
+
+		// Chase-Lev work-stealing deque with fixed capacity.
+		class Deque
+		{
+		public:
+			// Must be called only by the owner.
+			[[nodiscard]] Task* pop() noexcept
+			{
+				const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+				_bottom.store(bottom, std::memory_order_seq_cst);
+				auto top = _top.load(std::memory_order_seq_cst);
+				if (top > bottom)
+				{
+					_bottom.store(bottom + 1, std::memory_order_relaxed);
+					return nullptr;
+				}
+				auto task = _tasks[static_cast<size_t>(bottom) & kMask].load(std::memory_order_relaxed);
+				if (top == bottom)
+				{
+					// The last task may be being stolen.
+					if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						task = nullptr;
+					_bottom.store(bottom + 1, std::memory_order_relaxed);
+				}
+				return task;
+			}
+
+			// Must be called only by the owner. Returns false if the deque is full.
+			bool push(Task* task) noexcept
+			{
+				const auto bottom = _bottom.load(std::memory_order_relaxed);
+				if (bottom - _top.load(std::memory_order_acquire) >= static_cast<int64_t>(kDequeCapacity))
+					return false;
+				_tasks[static_cast<size_t>(bottom) & kMask].store(task, std::memory_order_relaxed);
+				_bottom.store(bottom + 1, std::memory_order_release);
+				return true;
+			}
+
+			[[nodiscard]] Task* steal() noexcept
+			{
+				auto top = _top.load(std::memory_order_seq_cst);
+				const auto bottom = _bottom.load(std::memory_order_seq_cst);
+				if (top >= bottom)
+					return nullptr;
+				const auto task = _tasks[static_cast<size_t>(top) & kMask].load(std::memory_order_relaxed);
+				return _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed) ? task : nullptr;
+			}
+
+		private:
+			static constexpr size_t kMask = kDequeCapacity - 1;
+
+			alignas(kCacheLineSize) std::atomic<int64_t> _top{ 0 };
+			alignas(kCacheLineSize) std::atomic<int64_t> _bottom{ 0 };
+			std::atomic<Task*> _tasks[kDequeCapacity]{};
+		};
+
+		struct Worker
+		{
+			ThreadPool& _pool;
+			Deque _deque;
+			std::thread _thread;
+
+			explicit Worker(ThreadPool& pool) noexcept
+				: _pool{ pool } {}
+		};
+
+		Task* allocateTask()
+		{
+			if (const auto task = _freeTasks.pop())
+				[[likely]]
+				return task;
+			return new Task;
+		}
+
+		// Returns a task from the current worker's deque, the shared queue or other workers' deques.
+		Task* findTask(Worker* current) noexcept
+		{
+			if (current)
+				if (const auto task = current->_deque.pop())
+					return task;
+			if (Task* task = nullptr; _queue.try_pop(task))
+				return task;
+			const auto workerCount = _workers.size();
+			const auto first = current ? static_cast<size_t>(current - _workers.data()) + 1 : 0;
+			for (size_t i = 0; i < workerCount; ++i)
+			{
+				auto& victim = _workers[(first + i) % workerCount];
+				if (&victim != current)
+					if (const auto task = victim._deque.steal())
+						return task;
+			}
+			return nullptr;
+		}
+
+		void freeTask(Task* task) noexcept
+		{
+			_freeTasks.push(task);
+		}
+
+		void run(Worker& worker) noexcept
+		{
+			_currentWorker = &worker;
+			for (int spins = 0; !_stopping.load(std::memory_order_acquire);)
+			{
+				if (const auto task = findTask(&worker))
+				{
+					task->run();
+					spins = 0;
+					continue;
+				}
+				if (++spins < kSpinCount)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+				spins = 0;
+				// Sleeping workers are counted, so that submitting a task doesn't notify anyone when all workers are busy.
+				const auto epoch = _epoch.load(std::memory_order_acquire);
+				_sleeping.fetch_add(1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst); // Pairs with the fence in submit().
+				if (const auto task = findTask(&worker))
+				{
+					_sleeping.fetch_sub(1, std::memory_order_relaxed);
+					task->run();
+					continue;
+				}
+				if (!_stopping.load(std::memory_order_acquire))
+					_epoch.wait(epoch, std::memory_order_acquire); // A changed epoch makes a preceding stop visible.
+				_sleeping.fetch_sub(1, std::memory_order_relaxed);
+			}
+			_currentWorker = nullptr;
+		}
+
+		// Stops and joins the started workers.
+		void stop() noexcept
+		{
+			_stopping.store(true, std::memory_order_release);
+			wake(true);
+			for (auto& worker : _workers)
+				if (worker._thread.joinable())
+					worker._thread.join();
+		}
+
+		void submit(Task* task) noexcept
+		{
+			const auto current = _currentWorker;
+			if (!(current && &current->_pool == this ? current->_deque.push(task) : _queue.try_push(task)))
+			{
+				task->run();
+				return;
+			}
+			std::atomic_thread_fence(std::memory_order_seq_cst); // The task must be visible to a worker which has just started sleeping.
+			if (_sleeping.load(std::memory_order_relaxed))
+				wake(false);
+		}
+
+		void wake(bool all) noexcept
+		{
+			_epoch.fetch_add(1, std::memory_order_seq_cst);
+			if (all)
+				_epoch.notify_all();
+			else
+				_epoch.notify_one();
+		}
+
+		// Executes other tasks until the group is complete.
+		void wait(TaskGroup&) noexcept;
+
+		RigidVector<Worker> _workers;
+		MpmcQueue<Task*, kQueueCapacity> _queue;
+		IntrusiveStack<Task> _freeTasks;
+		alignas(kCacheLineSize) std::atomic<uint32_t> _epoch{ 0 };
+		std::atomic<uint32_t> _sleeping{ 0 };
+		std::atomic<bool> _stopping{ false };
+
+		static thread_local Worker* _currentWorker;
+
+		friend TaskGroup;
+	};
+
+	inline thread_local ThreadPool::Worker* ThreadPool::_currentWorker = nullptr;
+
+	// Set of tasks which can be waited for. Small functions are stored inline in tasks,
+	// and functions which don't fit must be passed by reference (e.g. by capturing them by reference).
+	class TaskGroup
+	{
+	public:
+		constexpr explicit TaskGroup(ThreadPool& pool) noexcept
+			: _pool{ pool } {}
+
+		TaskGroup(const TaskGroup&) = delete;
+		~TaskGroup() noexcept { wait(); }
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		// Submits a function to be called without arguments.
+		template <typename F>
+		void run(F&& function)
+		{
+			const auto task = _pool.allocateTask();
+			task->set(std::forward<F>(function), *this);
+			_pending.fetch_add(1, std::memory_order_relaxed);
+			_pool.submit(task);
+		}
+
+		// Waits until all submitted functions have been called, executing tasks (including tasks of other groups) meanwhile.
+		void wait() noexcept
+		{
+			_pool.wait(*this);
+		}
+
+	private:
+		ThreadPool& _pool;
+		std::atomic<size_t> _pending{ 0 };
+
+		friend ThreadPool;
+	};
+
+	inline void ThreadPool::Task::run() noexcept
+	{
+		const auto group = _group;
+		_invoke(*this);
+		group->_pool.freeTask(this);
+		group->_pending.fetch_sub(1, std::memory_order_release); // The group may be destroyed right after that.
+	}
+
+	inline void ThreadPool::wait(TaskGroup& group) noexcept
+	{
+		const auto current = _currentWorker && &_currentWorker->_pool == this ? _currentWorker : nullptr;
+		for (int spins = 0; group._pending.load(std::memory_order_acquire);)
+		{
+			if (const auto task = findTask(current))
+			{
+				task->run();
+				spins = 0;
+			}
+			else if (++spins > kSpinCount)
+				std::this_thread::yield();
+		}
+	}
+
+	template <typename F>
+	void ThreadPool::parallel_for(size_t begin, size_t end, size_t grain, const F& function)
+	{
+		assert(grain > 0);
+		struct Range
+		{
+			TaskGroup& _group;
+			const F& _function;
+			size_t _grain;
+
+			// Submits the right halves of the range and processes the remaining part.
+			void operator()(size_t first, size_t last) const
+			{
+				while (last - first > _grain)
+				{
+					const auto middle = first + ((last - first - 1) / _grain + 1) / 2 * _grain;
+					_group.run([this, middle, last] { (*this)(middle, last); });
+					last = middle;
+				}
+				_function(first, last);
+			}
+		};
+		TaskGroup group{ *this };
+		const Range range{ group, function, grain };
+		if (begin < end)
+			range(begin, end);
+		group.wait(); // The tasks refer to the range.
+	}
+}
@@ -0,0 +1,201 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <primal/allocator.hpp>
+#include <primal/cache_line.hpp>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Allocation tracking can be compiled out by defining PRIMAL_ALLOCATION_TRACKING as 0,
+// which turns TrackingAllocator into its underlying allocator and makes all statistics zero.
+#ifndef PRIMAL_ALLOCATION_TRACKING
+#	define PRIMAL_ALLOCATION_TRACKING 1
+#endif
+
+namespace primal
+{
+	struct AllocationStats
+	{
+		// Histogram buckets are indexed by std::bit_width(size), i.e. bucket i counts sizes in [2^(i-1), 2^i).
+		static constexpr size_t kHistogramSize = 8 * sizeof(size_t) + 1;
+
+		size_t liveBytes = 0;
+		size_t peakBytes = 0;
+		size_t allocations = 0;
+		size_t deallocations = 0;
+		std::array<size_t, kHistogramSize> sizeHistogram{};
+	};
+
+	// Lock-free allocation counters shared by all allocators with the same tag.
+	// Counters are sharded by thread to avoid cache line contention. Live byte counts are
+	// published globally in batches, so peak bytes may be underestimated by up to kPeakPrecision.
+	template <typename Tag>
+	class AllocationTracker
+	{
+	public:
+		static constexpr size_t kShardCount = 16;
+		static constexpr size_t kPublishThreshold = size_t{ 1 } << 16;
+		static constexpr size_t kPeakPrecision = kShardCount * kPublishThreshold;
+
+		static void allocated([[maybe_unused]] size_t size) noexcept
+		{
+#if PRIMAL_ALLOCATION_TRACKING
+			auto& shard = currentShard();
+			shard._sizeHistogram[std::bit_width(size)].fetch_add(1, std::memory_order_relaxed);
+			updateLive(shard, static_cast<int64_t>(size));
+#endif
+		}
+
+		static void deallocated([[maybe_unused]] size_t size) noexcept
+		{
+#if PRIMAL_ALLOCATION_TRACKING
+			auto& shard = currentShard();
+			shard._deallocations.fetch_add(1, std::memory_order_relaxed);
+			updateLive(shard, -static_cast<int64_t>(size));
+#endif
+		}
+
+		[[nodiscard]] static AllocationStats snapshot() noexcept
+		{
+			AllocationStats stats;
+#if PRIMAL_ALLOCATION_TRACKING
+			auto liveBytes = _liveBytes.load(std::memory_order_relaxed);
+			for (const auto& shard : _shards)
+			{
+				liveBytes += shard._unpublished.load(std::memory_order_relaxed);
+				stats.deallocations += shard._deallocations.load(std::memory_order_relaxed);
+				for (size_t i = 0; i < AllocationStats::kHistogramSize; ++i)
+					stats.sizeHistogram[i] += shard._sizeHistogram[i].load(std::memory_order_relaxed);
+			}
+			for (const auto count : stats.sizeHistogram)
+				stats.allocations += count;
+			stats.liveBytes = liveBytes > 0 ? static_cast<size_t>(liveBytes) : 0;
+			const auto peakBytes = static_cast<size_t>(_peakBytes.load(std::memory_order_relaxed));
+			stats.peakBytes = peakBytes > stats.liveBytes ? peakBytes : stats.liveBytes;
+#endif
+			return stats;
+		}
+
+#if PRIMAL_ALLOCATION_TRACKING
+	private:
+		struct alignas(kCacheLineSize) Shard
+		{
+			std::atomic<int64_t> _unpublished{ 0 };
+			std::atomic<size_t> _deallocations{ 0 };
+			std::atomic<size_t> _sizeHistogram[AllocationStats::kHistogramSize]{};
+		};
+
+		static Shard& currentShard() noexcept
+		{
+			static std::atomic<size_t> nextShard{ 0 };
+			static thread_local size_t shardIndex = kShardCount;
+			if (shardIndex == kShardCount)
+				[[unlikely]]
+				shardIndex = nextShard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+			return _shards[shardIndex];
+		}
+
+		static void updateLive(Shard& shard, int64_t delta) noexcept
+		{
+			constexpr auto kThreshold = static_cast<int64_t>(kPublishThreshold);
+			const auto unpublished = shard._unpublished.fetch_add(delta, std::memory_order_relaxed) + delta;
+			if (unpublished < kThreshold && unpublished > -kThreshold)
+				[[likely]]
+				return;
+			const auto published = shard._unpublished.exchange(0, std::memory_order_relaxed);
+			const auto liveBytes = _liveBytes.fetch_add(published, std::memory_order_relaxed) + published;
+			for (auto peakBytes = _peakBytes.load(std::memory_order_relaxed); liveBytes > peakBytes;)
+				if (_peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+					break;
+		}
+
+		static inline Shard _shards[kShardCount];
+		alignas(kCacheLineSize) static inline std::atomic<int64_t> _liveBytes{ 0 };
+		static inline std::atomic<int64_t> _peakBytes{ 0 };
+#endif
+	};
+
+	// Allocator decorator which counts allocations in AllocationTracker<Tag>.
+	// Block sizes are stored in headers which preserve the alignment of the underlying allocator.
+	template <typename A, typename Tag>
+	class TrackingAllocator
+	{
+	public:
+		[[nodiscard]] static void* allocate(size_t size)
+		{
+#if PRIMAL_ALLOCATION_TRACKING
+			if (size > SIZE_MAX - kHeaderSize)
+				throw std::bad_alloc{};
+			const auto header = static_cast<std::byte*>(A::allocate(size + kHeaderSize));
+			*reinterpret_cast<size_t*>(header) = size;
+			AllocationTracker<Tag>::allocated(size);
+			return header + kHeaderSize;
+#else
+			return A::allocate(size);
+#endif
+		}
+
+		[[nodiscard]] static void* allocateZeroed(size_t size) requires requires { A::allocateZeroed(size); }
+		{
+#if PRIMAL_ALLOCATION_TRACKING
+			if (size > SIZE_MAX - kHeaderSize)
+				throw std::bad_alloc{};
+			const auto header = static_cast<std::byte*>(A::allocateZeroed(size + kHeaderSize));
+			*reinterpret_cast<size_t*>(header) = size;
+			AllocationTracker<Tag>::allocated(size);
+			return header + kHeaderSize;
+#else
+			return A::allocateZeroed(size);
+#endif
+		}
+
+		[[nodiscard]] static void* reallocate(void* memory, size_t size) requires requires { A::reallocate(memory, size); }
+		{
+#if PRIMAL_ALLOCATION_TRACKING
+			if (size > SIZE_MAX - kHeaderSize)
+				throw std::bad_alloc{};
+			const auto oldSize = *reinterpret_cast<const size_t*>(static_cast<std::byte*>(memory) - kHeaderSize);
+			const auto header = static_cast<std::byte*>(A::reallocate(static_cast<std::byte*>(memory) - kHeaderSize, size + kHeaderSize));
+			*reinterpret_cast<size_t*>(header) = size;
+			AllocationTracker<Tag>::deallocated(oldSize);
+			AllocationTracker<Tag>::allocated(size);
+			return header + kHeaderSize;
+#else
+			return A::reallocate(memory, size);
+#endif
+		}
+
+		static void deallocate(void* memory) noexcept
+		{
+#if PRIMAL_ALLOCATION_TRACKING
+			if (!memory)
+				return;
+			const auto header = static_cast<std::byte*>(memory) - kHeaderSize;
+			AllocationTracker<Tag>::deallocated(*reinterpret_cast<const size_t*>(header));
+			A::deallocate(header);
+#else
+			A::deallocate(memory);
+#endif
+		}
+
+		[[nodiscard]] static AllocationStats snapshot() noexcept
+		{
+			return AllocationTracker<Tag>::snapshot();
+		}
+
+#if PRIMAL_ALLOCATION_TRACKING
+	private:
+		static constexpr size_t kHeaderSize = kAllocatorAlignment<A> > sizeof(size_t) ? kAllocatorAlignment<A> : sizeof(size_t);
+#endif
+	};
+
+	template <typename A, typename Tag>
+	constexpr size_t kAllocatorAlignment<TrackingAllocator<A, Tag>> = kAllocatorAlignment<A>;
+}
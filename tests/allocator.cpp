@@ -56,6 +56,21 @@ TEST_CASE("CleanAllocator::allocate()")
 	CHECK(data + size == std::find_if(data, data + size, [](std::byte byte) { return std::to_integer<int>(byte) != 0; }));
 }
 
+TEST_CASE("CleanAllocator::allocate(large)")
+{
+	constexpr auto size = 2 * primal::CleanAllocator<primal::Allocator>::kLazyZeroingThreshold;
+	const auto check = [](void* pointer) {
+		REQUIRE(pointer);
+		const auto data = reinterpret_cast<std::byte*>(pointer);
+		CHECK(data + size == std::find_if(data, data + size, [](std::byte byte) { return std::to_integer<int>(byte) != 0; }));
+	};
+	check(CleanAllocatorPtr{ CleanAllocator::allocate(size) }.get());
+	using CleanAlignedAllocator = TestAllocator<primal::CleanAllocator<primal::AlignedAllocator<16>>>;
+	check(std::unique_ptr<void, CleanAlignedAllocator>{ CleanAlignedAllocator::allocate(size) }.get());
+	using CleanOveralignedAllocator = TestAllocator<primal::CleanAllocator<AlignedAllocator>>;
+	check(std::unique_ptr<void, CleanOveralignedAllocator>{ CleanOveralignedAllocator::allocate(size) }.get());
+}
+
 // std::malloc doesn't return nullptr in ASAN-less Clang builds.
 #if !defined(__clang__)
 
@@ -0,0 +1,94 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/arena_allocator.hpp>
+#include <primal/buffer.hpp>
+#include <primal/rigid_vector.hpp>
+
+#include <cstring>
+#include <thread>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("ArenaAllocator::allocate()")
+{
+	PRIMAL_ARENA_SCOPE();
+	const auto first = static_cast<std::byte*>(primal::ArenaAllocator<1>::allocate(1));
+	REQUIRE(first);
+	const auto second = static_cast<std::byte*>(primal::ArenaAllocator<1>::allocate(1));
+	CHECK(second == first + 1);
+	const auto aligned = primal::ArenaAllocator<64>::allocate(1);
+	CHECK(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+	const auto large = primal::ArenaAllocator<4096>::allocate(primal::Arena::kChunkSize);
+	REQUIRE(large);
+	CHECK(reinterpret_cast<uintptr_t>(large) % 4096 == 0);
+	static_cast<std::byte*>(large)[primal::Arena::kChunkSize - 1] = std::byte{ 1 };
+}
+
+TEST_CASE("ArenaAllocator::allocate(0)")
+{
+	void* empty = nullptr;
+	std::thread{ [&empty] {
+		PRIMAL_ARENA_SCOPE();
+		empty = primal::ArenaAllocator<>::allocate(0);
+	} }.join();
+	CHECK(empty);
+}
+
+TEST_CASE("ArenaAllocator thread exit")
+{
+	struct Guard
+	{
+		bool& _allocated;
+		~Guard()
+		{
+			PRIMAL_ARENA_SCOPE();
+			const auto pointer = primal::ArenaAllocator<>::allocate(32); // The thread's arena has already been destroyed.
+			std::memset(pointer, 0xff, 32);
+			_allocated = true;
+		}
+	};
+	bool allocated = false;
+	std::thread{ [&allocated] {
+		static thread_local Guard guard{ allocated };
+		static_cast<void>(primal::ArenaAllocator<>::allocate(32));
+	} }.join();
+	CHECK(allocated);
+}
+
+TEST_CASE("ArenaScope")
+{
+	PRIMAL_ARENA_SCOPE();
+	const auto before = primal::ArenaAllocator<>::allocate(1);
+	void* inner = nullptr;
+	{
+		PRIMAL_ARENA_SCOPE();
+		inner = primal::ArenaAllocator<>::allocate(1);
+		CHECK(inner != before);
+		{
+			PRIMAL_ARENA_SCOPE();
+			for (size_t i = 0; i < 4; ++i)
+				CHECK(primal::ArenaAllocator<>::allocate(primal::Arena::kChunkSize / 2));
+		}
+		CHECK(primal::ArenaAllocator<>::allocate(1) != inner);
+	}
+	CHECK(primal::ArenaAllocator<>::allocate(1) == inner);
+}
+
+TEST_CASE("ArenaAllocator containers")
+{
+	PRIMAL_ARENA_SCOPE();
+	primal::RigidVector<int, primal::ArenaAllocator<>> vector;
+	vector.reserve(3);
+	vector.emplace_back(1);
+	vector.emplace_back(2);
+	primal::Buffer<int, primal::ArenaAllocator<>> buffer{ 2 };
+	buffer.data()[0] = 3;
+	buffer.data()[1] = 4;
+	buffer.reserve(4);
+	CHECK(vector[0] == 1);
+	CHECK(vector[1] == 2);
+	CHECK(buffer.data()[0] == 3);
+	CHECK(buffer.data()[1] == 4);
+}
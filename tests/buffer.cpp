@@ -11,6 +11,32 @@
 
 namespace
 {
+	// Allocator with state which counts live blocks.
+	class CountingAllocator
+	{
+	public:
+		explicit CountingAllocator(int& counter) noexcept
+			: _counter{ &counter } {}
+
+		[[nodiscard]] void* allocate(size_t size)
+		{
+			++*_counter;
+			return primal::Allocator::allocate(size);
+		}
+
+		void deallocate(void* memory) noexcept
+		{
+			--*_counter;
+			primal::Allocator::deallocate(memory);
+		}
+
+	private:
+		int* _counter;
+	};
+
+	static_assert(sizeof(primal::Buffer<int>) == 2 * sizeof(void*));
+	static_assert(sizeof(primal::Buffer<int, CountingAllocator>) == 3 * sizeof(void*));
+
 	using Buffer = primal::Buffer<int, primal::CleanAllocator<primal::Allocator>>;
 
 	void check(Buffer& buffer, const std::vector<int>& expected, bool allocated = true)
@@ -75,6 +101,46 @@ TEST_CASE("Buffer::reserve()")
 	::check(buffer, { 0, 0, 0, 0, 0 });
 }
 
+TEST_CASE("Buffer::reserve() with reallocate()")
+{
+	primal::Buffer<int> buffer;
+	buffer.reserve(3);
+	std::iota(buffer.data(), buffer.data() + buffer.capacity(), 1);
+	buffer.reserve(1'000'000);
+	REQUIRE(buffer.capacity() == 1'000'000);
+	CHECK(buffer.data()[0] == 1);
+	CHECK(buffer.data()[1] == 2);
+	CHECK(buffer.data()[2] == 3);
+	buffer.data()[999'999] = 4;
+	buffer.reserve(2'000'000);
+	CHECK(buffer.data()[0] == 1);
+	CHECK(buffer.data()[999'999] == 4);
+}
+
+TEST_CASE("Buffer with a stateful allocator")
+{
+	int first = 0;
+	int second = 0;
+	{
+		primal::Buffer<int, CountingAllocator> buffer{ CountingAllocator{ first } };
+		CHECK(first == 0);
+		buffer.reserve(1);
+		CHECK(first == 1);
+		buffer.data()[0] = 1;
+		buffer.reserve(2);
+		CHECK(first == 1);
+		CHECK(buffer.data()[0] == 1);
+		primal::Buffer<int, CountingAllocator> otherBuffer{ 1, CountingAllocator{ second } };
+		CHECK(second == 1);
+		swap(buffer, otherBuffer);
+		otherBuffer.reserve(3);
+		CHECK(first == 1);
+		CHECK(second == 1);
+	}
+	CHECK(first == 0);
+	CHECK(second == 0);
+}
+
 TEST_CASE("swap(Buffer&, Buffer&)")
 {
 	Buffer first{ 3 };
@@ -0,0 +1,75 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/buffer_io.hpp>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("BufferWriter")
+{
+	primal::Buffer<std::byte> buffer;
+	primal::BufferWriter writer{ buffer };
+	CHECK(writer.size() == 0);
+	writer.appendBigEndian(uint16_t{ 0x0102 });
+	writer.appendLittleEndian(uint32_t{ 0x03040506 });
+	writer.append("\x07\x08", 2);
+	CHECK(writer.size() == 8);
+	CHECK(buffer.capacity() >= 8);
+	writer.reserve(9);
+	const auto capacity = buffer.capacity();
+	CHECK(capacity >= 17);
+	writer.appendBigEndianUnchecked(int8_t{ 9 });
+	writer.appendBigEndianUnchecked(uint64_t{ 0x0a0b0c0d0e0f1011 });
+	CHECK(buffer.capacity() == capacity);
+	REQUIRE(writer.size() == 17);
+	CHECK(writer.data() == buffer.data());
+	CHECK(std::memcmp(buffer.data(), "\x01\x02\x06\x05\x04\x03\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11", 17) == 0);
+	for (size_t i = 0; i < 1000; ++i)
+		writer.appendLittleEndian(static_cast<uint16_t>(i));
+	CHECK(writer.size() == 2017);
+	CHECK(buffer.capacity() >= 2017);
+	CHECK(buffer.capacity() < 2 * 2017);
+}
+
+TEST_CASE("BufferWriter::appendUnchecked()")
+{
+	primal::Buffer<std::byte> buffer;
+	primal::BufferWriter writer{ buffer };
+	writer.appendUnchecked(nullptr, 0);
+	CHECK(writer.size() == 0);
+	CHECK_FALSE(buffer.data());
+}
+
+TEST_CASE("BufferReader")
+{
+	primal::BufferReader reader{ "\x01\x02\x03\x04\x05\x06\x07\x08\x00\x00\x80\x3f", 12 };
+	CHECK(reader.remaining() == 12);
+	uint16_t u16 = 0;
+	REQUIRE(reader.readBigEndian(u16));
+	CHECK(u16 == 0x0102);
+	uint32_t u32 = 0;
+	REQUIRE(reader.readLittleEndian(u32));
+	CHECK(u32 == 0x06050403);
+	REQUIRE(reader.canRead(6));
+	CHECK(reader.readLittleEndianUnchecked<int8_t>() == 7);
+	CHECK(reader.readBigEndianUnchecked<uint8_t>() == 8);
+	CHECK(reader.readLittleEndianUnchecked<float>() == 1.f);
+	CHECK(reader.remaining() == 0);
+	uint64_t u64 = 42;
+	CHECK_FALSE(reader.readBigEndian(u64));
+	CHECK(u64 == 42);
+	CHECK_FALSE(reader.skip(1));
+	char byte = 0;
+	CHECK_FALSE(reader.read(&byte, 1));
+}
+
+TEST_CASE("BufferReader::skip()")
+{
+	primal::BufferReader reader{ "\x01\x02\x03", 3 };
+	CHECK(reader.skip(2));
+	CHECK(*reader.current() == std::byte{ 3 });
+	char byte = 0;
+	CHECK(reader.read(&byte, 1));
+	CHECK(byte == 3);
+}
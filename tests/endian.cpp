@@ -15,6 +15,7 @@ TEST_CASE("bigEndian(T)")
 	{
 		CHECK(primal::bigEndian(uint16_t{ 0x8081 }) == 0x8180);
 		CHECK(primal::bigEndian(uint32_t{ 0x80818283 }) == 0x83828180);
+		CHECK(primal::bigEndian(uint64_t{ 0x8081828384858687 }) == 0x8786858483828180);
 	}
 	if constexpr (std::endian::native == std::endian::big)
 	{
@@ -23,6 +24,27 @@ TEST_CASE("bigEndian(T)")
 	}
 }
 
+TEST_CASE("bigEndian(T) for other types")
+{
+	enum class Enum : uint16_t
+	{
+		Value = 0x8081,
+	};
+	if constexpr (std::endian::native == std::endian::little)
+	{
+		CHECK(primal::bigEndian(int8_t{ -2 }) == -2);
+		CHECK(primal::bigEndian(int32_t{ 0x00010203 }) == 0x03020100);
+		CHECK(primal::bigEndian(Enum::Value) == Enum{ 0x8180 });
+		CHECK(primal::bigEndian(primal::bigEndian(1.5)) == 1.5);
+		CHECK(std::bit_cast<uint32_t>(primal::bigEndian(1.f)) == 0x0000803f);
+	}
+	if constexpr (std::endian::native == std::endian::big)
+	{
+		CHECK(primal::bigEndian(int32_t{ 0x00010203 }) == 0x00010203);
+		CHECK(primal::bigEndian(Enum::Value) == Enum::Value);
+	}
+}
+
 TEST_CASE("littleEndian(T)")
 {
 	if constexpr (std::endian::native == std::endian::little)
@@ -64,3 +86,8 @@ TEST_CASE("swapBytes(uint32_t)")
 {
 	CHECK(primal::swapBytes(uint32_t{ 0x80818283 }) == 0x83828180);
 }
+
+TEST_CASE("swapBytes(uint64_t)")
+{
+	CHECK(primal::swapBytes(uint64_t{ 0x8081828384858687 }) == 0x8786858483828180);
+}
@@ -0,0 +1,163 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/flat_hash_map.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	// Hash which puts all keys into the same probe sequence.
+	struct CollidingHash
+	{
+		size_t operator()(int) const noexcept { return 0; }
+	};
+}
+
+TEST_CASE("FlatHashMap")
+{
+	primal::FlatHashMap<int, std::string> map;
+	CHECK(map.empty());
+	CHECK(map.capacity() == 0);
+	CHECK(map.begin() == map.end());
+	CHECK_FALSE(map.find(1));
+	CHECK_FALSE(map.erase(1));
+	const auto [value, inserted] = map.try_emplace(1, "one");
+	CHECK(inserted);
+	REQUIRE(value);
+	CHECK(*value == "one");
+	CHECK(map.size() == 1);
+	CHECK(map.capacity() == 16);
+	const auto [existing, insertedAgain] = map.try_emplace(1, "uno");
+	CHECK_FALSE(insertedAgain);
+	CHECK(existing == value);
+	CHECK(*existing == "one");
+	map[2] = "two";
+	CHECK(map.size() == 2);
+	CHECK(map.contains(2));
+	CHECK_FALSE(map.contains(3));
+	SUBCASE("erase()")
+	{
+		CHECK(map.erase(1));
+		CHECK_FALSE(map.erase(1));
+		CHECK(map.size() == 1);
+		CHECK_FALSE(map.find(1));
+		CHECK(*map.find(2) == "two");
+	}
+	SUBCASE("iteration")
+	{
+		size_t count = 0;
+		for (const auto [key, mapped] : std::as_const(map))
+		{
+			CHECK(mapped == (key == 1 ? "one" : "two"));
+			++count;
+		}
+		CHECK(count == 2);
+		for (auto [key, mapped] : map)
+			mapped += '!';
+		CHECK(*map.find(1) == "one!");
+	}
+	SUBCASE("clear()")
+	{
+		map.clear();
+		CHECK(map.empty());
+		CHECK(map.capacity() == 16);
+		CHECK(map.begin() == map.end());
+		CHECK_FALSE(map.find(1));
+	}
+	SUBCASE("FlatHashMap(FlatHashMap&&)")
+	{
+		auto other = std::move(map);
+		CHECK(map.empty());
+		CHECK(map.capacity() == 0);
+		CHECK_FALSE(map.find(1));
+		CHECK(*other.find(2) == "two");
+	}
+}
+
+TEST_CASE("FlatHashMap growth")
+{
+	primal::FlatHashMap<int, std::unique_ptr<int>> map;
+	std::unordered_map<int, int> reference;
+	uint32_t random = 1;
+	for (int i = 0; i < 100'000; ++i)
+	{
+		random = random * 1664525 + 1013904223;
+		const auto key = static_cast<int>(random >> 16);
+		if (random & 0x8000)
+		{
+			const auto [value, inserted] = map.try_emplace(key, std::make_unique<int>(i));
+			CHECK(inserted == reference.emplace(key, i).second);
+		}
+		else
+			CHECK(map.erase(key) == (reference.erase(key) > 0));
+	}
+	CHECK(map.size() == reference.size());
+	for (const auto& [key, value] : reference)
+	{
+		const auto found = map.find(key);
+		REQUIRE(found);
+		CHECK(**found == value);
+	}
+	size_t count = 0;
+	for (const auto [key, value] : map)
+	{
+		CHECK(reference.at(key) == *value);
+		++count;
+	}
+	CHECK(count == reference.size());
+}
+
+TEST_CASE("FlatHashMap collisions")
+{
+	primal::FlatHashMap<int, int, CollidingHash> map;
+	for (int i = 0; i < 100; ++i)
+		map[i] = i;
+	for (int i = 0; i < 100; i += 2)
+		CHECK(map.erase(i));
+	for (int i = 0; i < 100; ++i)
+	{
+		const auto value = map.find(i);
+		CHECK(static_cast<bool>(value) == (i % 2 == 1));
+	}
+	for (int i = 0; i < 1000; ++i) // Tombstones must be reclaimed.
+	{
+		map[1000 + i] = i;
+		CHECK(map.erase(1000 + i));
+	}
+	CHECK(map.size() == 50);
+	CHECK(map.capacity() <= 256);
+}
+
+TEST_CASE("FlatHashMap::reserve()")
+{
+	primal::FlatHashMap<int, int> map;
+	map.reserve(100);
+	const auto capacity = map.capacity();
+	CHECK(capacity >= 100);
+	for (int i = 0; i < 100; ++i)
+		map[i] = i;
+	CHECK(map.capacity() == capacity);
+}
+
+TEST_CASE("FlatHashMap::try_emplace() with an existing value")
+{
+	primal::FlatHashMap<int, std::string> map;
+	const std::string value(100, 'a'); // Too long for the small string optimization.
+	map.try_emplace(0, value);
+	const auto capacity = map.capacity();
+	for (int i = 1; map.size() < capacity - capacity / 8; ++i) // Fill the map up to the growth limit.
+		map.try_emplace(i, value);
+	REQUIRE(map.capacity() == capacity);
+	const auto [copy, inserted] = map.try_emplace(-1, *map.find(0));
+	CHECK(inserted);
+	CHECK(map.capacity() > capacity);
+	REQUIRE(copy);
+	CHECK(*copy == value);
+	CHECK(*map.find(0) == value);
+}
@@ -0,0 +1,74 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/flat_map.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("FlatSet")
+{
+	for (size_t size = 0; size <= 100; ++size)
+	{
+		INFO("size = " << size);
+		std::vector<int> sorted(size);
+		for (size_t i = 0; i < size; ++i)
+			sorted[i] = static_cast<int>(i * 2 + 1); // Odd numbers only.
+		const primal::FlatSet<int> set{ sorted };
+		CHECK(set.size() == size);
+		CHECK(set.empty() == !size);
+		std::vector<int> keys;
+		for (int key = -1; key <= static_cast<int>(size * 2 + 1); ++key)
+		{
+			keys.emplace_back(key);
+			CHECK(set.contains(key) == (key % 2 && key > 0 && key < static_cast<int>(size * 2)));
+			const auto expected = std::lower_bound(sorted.begin(), sorted.end(), key);
+			const auto found = set.lower_bound(key);
+			if (expected == sorted.end())
+				CHECK_FALSE(found);
+			else
+			{
+				REQUIRE(found);
+				CHECK(*found == *expected);
+			}
+		}
+		const auto results = std::make_unique<bool[]>(keys.size());
+		set.contains(keys, { results.get(), keys.size() });
+		for (size_t i = 0; i < keys.size(); ++i)
+			CHECK(results[i] == set.contains(keys[i]));
+	}
+}
+
+TEST_CASE("FlatMap")
+{
+	const std::vector<uint64_t> keys{ 10, 20, 30, 40, 50 };
+	const std::vector<float> values{ 1, 2, 3, 4, 5 };
+	primal::FlatMap<uint64_t, float> map{ keys, values };
+	CHECK(map.size() == 5);
+	CHECK(map.contains(30));
+	CHECK_FALSE(map.contains(35));
+	CHECK_FALSE(map.find(0));
+	CHECK_FALSE(map.find(60));
+	REQUIRE(map.find(40));
+	CHECK(*map.find(40) == 4);
+	*map.find(40) = 44;
+	CHECK(*std::as_const(map).find(40) == 44);
+	std::vector<uint64_t> queries;
+	for (uint64_t key = 0; key <= 60; key += 5)
+		queries.emplace_back(key);
+	std::vector<const float*> results(queries.size());
+	map.find(queries, results);
+	for (size_t i = 0; i < queries.size(); ++i)
+		CHECK(results[i] == std::as_const(map).find(queries[i]));
+	SUBCASE("FlatMap(FlatMap&&)")
+	{
+		auto other = std::move(map);
+		CHECK(map.empty());
+		CHECK_FALSE(map.find(10));
+		CHECK(*other.find(10) == 1);
+	}
+}
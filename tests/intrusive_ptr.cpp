@@ -0,0 +1,152 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/intrusive_ptr.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	template <typename Policy>
+	struct Value : primal::RefCounted<Policy>
+	{
+		unsigned _deletions = 0;
+	};
+
+	struct CountingDeleter
+	{
+		template <typename T>
+		void free(T* pointer) noexcept
+		{
+			++pointer->_deletions;
+		}
+	};
+
+	template <typename Policy>
+	void testIntrusivePtr()
+	{
+		using Ptr = primal::IntrusivePtr<Value<Policy>, Policy, CountingDeleter>;
+
+		Value<Policy> value;
+		Value<Policy> otherValue;
+		unsigned expectedOtherDeletions = 0;
+		{
+			Ptr ptr{ &value };
+			CHECK(ptr.get() == &value);
+			CHECK(&ptr->_deletions == &value._deletions);
+			SUBCASE("IntrusivePtr(const IntrusivePtr&)")
+			{
+				{
+					Ptr copy{ ptr };
+					CHECK(copy.get() == &value);
+					CHECK(ptr.get() == &value);
+				}
+				CHECK(value._deletions == 0);
+			}
+			SUBCASE("IntrusivePtr(IntrusivePtr&&)")
+			{
+				Ptr otherPtr{ std::move(ptr) };
+				CHECK_FALSE(ptr);
+				CHECK(otherPtr.get() == &value);
+				CHECK(value._deletions == 0);
+			}
+			SUBCASE("operator=(const IntrusivePtr&)")
+			{
+				Ptr otherPtr{ &otherValue };
+				otherPtr = ptr;
+				CHECK(otherValue._deletions == 1);
+				CHECK(otherPtr.get() == &value);
+				CHECK(value._deletions == 0);
+				expectedOtherDeletions = 1;
+			}
+			SUBCASE("reset()")
+			{
+				Ptr copy{ ptr };
+				ptr.reset();
+				CHECK_FALSE(ptr);
+				CHECK(value._deletions == 0);
+				copy.reset(&otherValue);
+				CHECK(copy.get() == &otherValue);
+				CHECK(value._deletions == 1);
+				CHECK(otherValue._deletions == 0);
+				expectedOtherDeletions = 1;
+			}
+			SUBCASE("Value(const Value&)")
+			{
+				auto copy = value; // Must not copy the references.
+				{
+					Ptr copyPtr{ &copy };
+				}
+				CHECK(copy._deletions == 1);
+				CHECK(value._deletions == 0);
+			}
+		}
+		CHECK(value._deletions == 1);
+		CHECK(otherValue._deletions == expectedOtherDeletions);
+	}
+}
+
+TEST_CASE("IntrusivePtr<AtomicRefCount>")
+{
+	testIntrusivePtr<primal::AtomicRefCount>();
+}
+
+TEST_CASE("IntrusivePtr<LocalRefCount>")
+{
+	testIntrusivePtr<primal::LocalRefCount>();
+}
+
+TEST_CASE("IntrusivePtr threads")
+{
+	struct Object : primal::RefCounted<>
+	{
+		std::atomic<unsigned>* _deletions = nullptr;
+		explicit Object(std::atomic<unsigned>* deletions) noexcept
+			: _deletions{ deletions } {}
+		~Object() noexcept { ++*_deletions; }
+	};
+
+	std::atomic<unsigned> deletions{ 0 };
+	{
+		primal::IntrusivePtr<Object> ptr{ new Object{ &deletions } };
+		std::vector<std::thread> threads;
+		for (int i = 0; i < 4; ++i)
+			threads.emplace_back([&ptr] {
+				for (int j = 0; j < 10'000; ++j)
+				{
+					auto copy = ptr;
+					auto moved = std::move(copy);
+				}
+			});
+		for (auto& thread : threads)
+			thread.join();
+		CHECK(deletions == 0);
+	}
+	CHECK(deletions == 1);
+}
+
+TEST_CASE("IntrusivePtr with an incomplete type")
+{
+	struct Node : primal::RefCounted<primal::LocalRefCount>
+	{
+		primal::IntrusivePtr<Node, primal::LocalRefCount> _next;
+		unsigned* _deletions = nullptr;
+		explicit Node(unsigned* deletions) noexcept
+			: _deletions{ deletions } {}
+		~Node() noexcept { ++*_deletions; }
+	};
+
+	unsigned deletions = 0;
+	{
+		primal::IntrusivePtr<Node, primal::LocalRefCount> head{ new Node{ &deletions } };
+		head->_next.reset(new Node{ &deletions });
+		head->_next->_next.reset(new Node{ &deletions });
+		CHECK(deletions == 0);
+	}
+	CHECK(deletions == 3);
+}
@@ -0,0 +1,93 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/intrusive_stack.hpp>
+
+#include <array>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	struct Item : primal::IntrusiveNode
+	{
+		int _value = 0;
+		std::atomic<int> _owners{ 0 };
+	};
+}
+
+TEST_CASE("IntrusiveStack")
+{
+	std::array<Item, 4> items;
+	for (int i = 0; i < 4; ++i)
+		items[static_cast<size_t>(i)]._value = i;
+	primal::IntrusiveStack<Item> stack;
+	CHECK(stack.empty());
+	CHECK_FALSE(stack.pop());
+	stack.push(&items[0]);
+	stack.push(&items[1]);
+	CHECK_FALSE(stack.empty());
+	SUBCASE("pop()")
+	{
+		CHECK(stack.pop() == &items[1]);
+		stack.push(&items[2]);
+		CHECK(stack.pop() == &items[2]);
+		CHECK(stack.pop() == &items[0]);
+		CHECK_FALSE(stack.pop());
+		CHECK(stack.empty());
+	}
+	SUBCASE("pushList()")
+	{
+		items[2]._next = &items[3];
+		stack.pushList(&items[2], &items[3]);
+		for (const auto index : { 2, 3, 1, 0 })
+			CHECK(stack.pop() == &items[static_cast<size_t>(index)]);
+		CHECK(stack.empty());
+	}
+	SUBCASE("popAll()")
+	{
+		const auto top = stack.popAll();
+		CHECK(stack.empty());
+		CHECK(top == &items[1]);
+		CHECK(top->_next == &items[0]);
+		CHECK_FALSE(items[0]._next);
+		CHECK_FALSE(stack.popAll());
+	}
+}
+
+TEST_CASE("IntrusiveStack stress")
+{
+	constexpr size_t kThreads = 4;
+	constexpr size_t kItems = 16; // Few items make the same items return to the top often, provoking ABA.
+	constexpr int kIterations = 50'000;
+	std::array<Item, kItems> items;
+	primal::IntrusiveStack<Item> stack;
+	for (auto& item : items)
+		stack.push(&item);
+	std::atomic<bool> failed{ false };
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < kThreads; ++i)
+		threads.emplace_back([&] {
+			for (int j = 0; j < kIterations; ++j)
+			{
+				const auto item = stack.pop();
+				if (!item)
+					continue;
+				if (item->_owners.fetch_add(1) != 0) // No other thread may have the same item.
+					failed = true;
+				++item->_value;
+				item->_owners.fetch_sub(1);
+				stack.push(item);
+			}
+		});
+	for (auto& thread : threads)
+		thread.join();
+	CHECK_FALSE(failed);
+	size_t count = 0;
+	while (stack.pop())
+		++count;
+	CHECK(count == kItems);
+}
@@ -0,0 +1,126 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/large_page_allocator.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	template <typename A>
+	void checkAllocation(size_t size)
+	{
+		const auto pointer = A::allocate(size);
+		REQUIRE(pointer);
+		CHECK(reinterpret_cast<uintptr_t>(pointer) % A::kAlignment == 0);
+		std::memset(pointer, 0xff, size);
+		A::deallocate(pointer);
+	}
+}
+
+TEST_CASE("LargePageAllocator::allocate()")
+{
+	using Allocator = primal::LargePageAllocator<>;
+	::checkAllocation<Allocator>(1);
+	::checkAllocation<Allocator>(Allocator::hugePageSize() - Allocator::kAlignment - 1);
+	::checkAllocation<Allocator>(Allocator::hugePageSize() - Allocator::kAlignment);
+	::checkAllocation<Allocator>(3 * Allocator::hugePageSize());
+	Allocator::deallocate(nullptr);
+}
+
+TEST_CASE("LargePageAllocator::reallocate()")
+{
+	using Allocator = primal::LargePageAllocator<>;
+	const auto sizes = { size_t{ 16 }, size_t{ 64 }, 2 * Allocator::hugePageSize(), 2 * Allocator::hugePageSize() + 1, 5 * Allocator::hugePageSize(), size_t{ 32 } };
+	auto data = static_cast<unsigned char*>(Allocator::allocate(2));
+	data[0] = 1;
+	data[1] = 2;
+	size_t oldSize = 2;
+	for (const auto size : sizes)
+	{
+		INFO("size = ", size);
+		data = static_cast<unsigned char*>(Allocator::reallocate(data, size));
+		REQUIRE(data);
+		CHECK(reinterpret_cast<uintptr_t>(data) % Allocator::kAlignment == 0);
+		CHECK(data[0] == 1);
+		if (size > oldSize)
+			CHECK(data[oldSize - 1] == 2);
+		data[size - 1] = 2;
+		oldSize = size;
+	}
+	Allocator::deallocate(data);
+}
+
+#ifdef __linux__
+TEST_CASE("LargePageAllocator::reallocate() without mremap()")
+{
+	using Allocator = primal::LargePageAllocator<>;
+	const auto size = 2 * Allocator::hugePageSize();
+	const auto data = static_cast<unsigned char*>(Allocator::allocate(size));
+	REQUIRE(data);
+	std::memset(data, 1, size);
+	// Different protection splits the mapping, which makes mremap() fail like it does for MAP_HUGETLB mappings.
+	const auto pageSize = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+	const auto lastPage = (reinterpret_cast<uintptr_t>(data) + size - 1) & ~(pageSize - 1);
+	REQUIRE(::mprotect(reinterpret_cast<void*>(lastPage), pageSize, PROT_READ) == 0);
+	const auto newData = static_cast<unsigned char*>(Allocator::reallocate(data, 2 * size));
+	REQUIRE(newData);
+	CHECK(newData != data);
+	CHECK((reinterpret_cast<uintptr_t>(newData) - Allocator::kAlignment) % Allocator::hugePageSize() == 0);
+	CHECK(std::all_of(newData, newData + size, [](unsigned char value) { return value == 1; }));
+	newData[2 * size - 1] = 2;
+	Allocator::deallocate(newData);
+}
+
+#	ifdef MAP_FIXED_NOREPLACE
+TEST_CASE("LargePageAllocator::reallocate() with moving")
+{
+	using Allocator = primal::LargePageAllocator<>;
+	const auto hugePageSize = Allocator::hugePageSize();
+	const auto size = 2 * hugePageSize;
+	const auto data = static_cast<unsigned char*>(Allocator::allocate(size));
+	REQUIRE(data);
+	std::memset(data, 1, size);
+	// The block is mapped with an extra huge page for the header, and the next mapping prevents growing in place.
+	const auto pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+	const auto blocker = ::mmap(data - Allocator::kAlignment + 3 * hugePageSize, pageSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+	REQUIRE(blocker != MAP_FAILED);
+	const auto newData = static_cast<unsigned char*>(Allocator::reallocate(data, 2 * size));
+	::munmap(blocker, pageSize);
+	REQUIRE(newData);
+	CHECK(newData != data);
+	CHECK((reinterpret_cast<uintptr_t>(newData) - Allocator::kAlignment) % hugePageSize == 0);
+	CHECK(std::all_of(newData, newData + size, [](unsigned char value) { return value == 1; }));
+	newData[2 * size - 1] = 2;
+	Allocator::deallocate(newData);
+}
+#	endif
+#endif
+
+TEST_CASE("CleanAllocator<LargePageAllocator>::allocate()")
+{
+	using Allocator = primal::CleanAllocator<primal::LargePageAllocator<>>;
+	for (const auto size : { size_t{ 1 }, Allocator::kLazyZeroingThreshold, 3 * primal::LargePageAllocator<>::hugePageSize() })
+	{
+		const auto data = static_cast<std::byte*>(Allocator::allocate(size));
+		REQUIRE(data);
+		CHECK(data + size == std::find_if(data, data + size, [](std::byte byte) { return std::to_integer<int>(byte) != 0; }));
+		Allocator::deallocate(data);
+	}
+}
+
+TEST_CASE("LargePageAllocator<NumaNodeBinding>::allocate()")
+{
+	using Allocator = primal::LargePageAllocator<primal::NumaNodeBinding<0>>;
+	::checkAllocation<Allocator>(1);
+	::checkAllocation<Allocator>(3 * Allocator::hugePageSize());
+}
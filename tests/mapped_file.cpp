@@ -0,0 +1,84 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/mapped_file.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	class TemporaryFile
+	{
+	public:
+		// The name gets a random suffix, so concurrent test runs don't collide.
+		TemporaryFile(const char* name, const char* contents, size_t size)
+			: _path{ std::filesystem::temp_directory_path() / (std::string{ name } + '_' + std::to_string(std::random_device{}()) + ".tmp") }
+		{
+			std::ofstream{ _path, std::ios::binary }.write(contents, static_cast<std::streamsize>(size));
+		}
+
+		~TemporaryFile() noexcept
+		{
+			std::error_code error;
+			std::filesystem::remove(_path, error);
+		}
+
+		const std::filesystem::path& path() const noexcept { return _path; }
+
+	private:
+		const std::filesystem::path _path;
+	};
+}
+
+TEST_CASE("MappedFile")
+{
+	constexpr char contents[] = "Hello, world!";
+	const TemporaryFile file{ "primal_mapped_file", contents, sizeof contents };
+	auto mapped = primal::MappedFile::open(file.path());
+	REQUIRE(mapped.data());
+	REQUIRE(mapped.size() == sizeof contents);
+	CHECK(std::memcmp(mapped.data(), contents, sizeof contents) == 0);
+	SUBCASE("advise()")
+	{
+		CHECK(mapped.advise(primal::MappedFile::Advice::Normal));
+		CHECK(mapped.advise(primal::MappedFile::Advice::WillNeed));
+#ifndef _WIN32
+		CHECK(mapped.advise(primal::MappedFile::Advice::Sequential));
+		CHECK(mapped.advise(primal::MappedFile::Advice::Random));
+#endif
+		static_cast<void>(mapped.advise(primal::MappedFile::Advice::HugePage)); // May be unsupported for files.
+	}
+	SUBCASE("MappedFile(MappedFile&&)")
+	{
+		const auto data = mapped.data();
+		const primal::MappedFile other{ std::move(mapped) };
+		CHECK_FALSE(mapped.data());
+		CHECK(mapped.size() == 0);
+		CHECK_FALSE(mapped.advise(primal::MappedFile::Advice::Normal));
+		CHECK(other.data() == data);
+		CHECK(other.size() == sizeof contents);
+	}
+	SUBCASE("operator=(MappedFile&&)")
+	{
+		auto populated = primal::MappedFile::open(file.path(), true);
+		REQUIRE(populated.data());
+		mapped = std::move(populated);
+		CHECK(std::memcmp(mapped.data(), contents, sizeof contents) == 0);
+	}
+}
+
+TEST_CASE("MappedFile::open()")
+{
+	const TemporaryFile file{ "primal_mapped_file_empty", "", 0 };
+	const auto empty = primal::MappedFile::open(file.path());
+	CHECK_FALSE(empty.data());
+	CHECK(empty.size() == 0);
+	const auto missing = primal::MappedFile::open(file.path().string() + ".missing");
+	CHECK_FALSE(missing.data());
+}
@@ -0,0 +1,58 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/mirrored_ring_buffer.hpp>
+
+#include <cstring>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("MirroredRingBuffer")
+{
+	primal::MirroredRingBuffer ring{ 1 };
+	const auto size = ring.size();
+	REQUIRE(size >= 4096);
+	CHECK(std::has_single_bit(size));
+	CHECK(ring.readable() == 0);
+	CHECK(ring.writable() == size);
+	SUBCASE("mirroring")
+	{
+		ring.data()[0] = std::byte{ 1 };
+		CHECK(ring.data()[size] == std::byte{ 1 });
+		ring.data()[2 * size - 1] = std::byte{ 2 };
+		CHECK(ring.data()[size - 1] == std::byte{ 2 });
+	}
+	SUBCASE("wraparound")
+	{
+		ring.commitWrite(size - 3);
+		ring.commitRead(size - 3);
+		const auto writeRegion = ring.writeRegion();
+		REQUIRE(writeRegion.size() == size);
+		CHECK(writeRegion.data() == ring.data() + size - 3);
+		std::memcpy(writeRegion.data(), "abcdef", 6);
+		ring.commitWrite(6);
+		CHECK(ring.readable() == 6);
+		CHECK(ring.writable() == size - 6);
+		const auto readRegion = ring.readRegion();
+		REQUIRE(readRegion.size() == 6);
+		CHECK(std::memcmp(readRegion.data(), "abcdef", 6) == 0);
+		CHECK(std::memcmp(ring.data(), "def", 3) == 0);
+		ring.commitRead(4);
+		CHECK(ring.readRegion().data() == ring.data() + 1);
+		CHECK(ring.writeRegion().data() == ring.data() + 3);
+		CHECK(ring.writeRegion().size() == size - 2);
+	}
+	SUBCASE("MirroredRingBuffer(MirroredRingBuffer&&)")
+	{
+		ring.commitWrite(5);
+		const auto data = ring.data();
+		primal::MirroredRingBuffer other{ std::move(ring) };
+		CHECK_FALSE(ring.data());
+		CHECK(ring.size() == 0);
+		CHECK(ring.readable() == 0);
+		CHECK(other.data() == data);
+		CHECK(other.size() == size);
+		CHECK(other.readable() == 5);
+	}
+}
@@ -0,0 +1,120 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/mpmc_queue.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	struct Counted
+	{
+		Counted() noexcept { ++_count; }
+		Counted(Counted&&) noexcept { ++_count; }
+		~Counted() noexcept { --_count; }
+		Counted& operator=(Counted&&) noexcept = default;
+
+		static inline int _count = 0;
+	};
+}
+
+TEST_CASE("MpmcQueue")
+{
+	primal::MpmcQueue<std::unique_ptr<int>, 4> queue;
+	std::unique_ptr<int> value;
+	CHECK_FALSE(queue.try_pop(value));
+	for (int i = 0; i < 4; ++i)
+		CHECK(queue.try_push(std::make_unique<int>(i)));
+	CHECK_FALSE(queue.try_push(std::make_unique<int>(4)));
+	REQUIRE(queue.try_pop(value));
+	REQUIRE(value);
+	CHECK(*value == 0);
+	SUBCASE("push()")
+	{
+		queue.push(std::make_unique<int>(4));
+		for (int i = 1; i <= 4; ++i)
+			CHECK(*queue.pop() == i);
+		CHECK_FALSE(queue.try_pop(value));
+	}
+	SUBCASE("try_pop_n()")
+	{
+		CHECK(queue.try_push(std::make_unique<int>(4)));
+		std::array<std::unique_ptr<int>, 3> values;
+		CHECK(queue.try_pop_n(values.data(), 0) == 0);
+		REQUIRE(queue.try_pop_n(values.data(), values.size()) == 3);
+		for (int i = 0; i < 3; ++i)
+			CHECK(*values[static_cast<size_t>(i)] == i + 1);
+		REQUIRE(queue.try_pop_n(values.data(), values.size()) == 1);
+		CHECK(*values[0] == 4);
+		CHECK(queue.try_pop_n(values.data(), values.size()) == 0);
+	}
+}
+
+TEST_CASE("MpmcQueue::~MpmcQueue()")
+{
+	{
+		primal::MpmcQueue<Counted, 4> queue;
+		for (int i = 0; i < 4; ++i)
+			CHECK(queue.try_push());
+		static_cast<void>(queue.pop());
+		CHECK(queue.try_push());
+		CHECK(Counted::_count == 4);
+	}
+	CHECK(Counted::_count == 0);
+}
+
+TEST_CASE("MpmcQueue stress")
+{
+	constexpr size_t kThreads = 4;
+	constexpr uint64_t kItemsPerProducer = 50'000;
+	primal::MpmcQueue<uint64_t, 64> queue;
+	std::atomic<uint64_t> sum{ 0 };
+	std::atomic<uint64_t> count{ 0 };
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < kThreads; ++i)
+	{
+		threads.emplace_back([&queue, i] {
+			for (uint64_t j = 1; j <= kItemsPerProducer; ++j)
+				if (i % 2)
+					queue.push(j);
+				else
+					while (!queue.try_push(j))
+						std::this_thread::yield();
+		});
+		threads.emplace_back([&queue, &sum, &count, i] {
+			uint64_t localSum = 0;
+			uint64_t localCount = 0;
+			std::array<uint64_t, 8> values{};
+			while (localCount < kItemsPerProducer)
+				if (i % 2)
+				{
+					localSum += queue.pop();
+					++localCount;
+				}
+				else if (const auto popped = queue.try_pop_n(values.data(), std::min<size_t>(values.size(), kItemsPerProducer - localCount)))
+				{
+					for (size_t k = 0; k < popped; ++k)
+						localSum += values[k];
+					localCount += popped;
+				}
+				else
+					std::this_thread::yield();
+			sum += localSum;
+			count += localCount;
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	CHECK(count == kThreads * kItemsPerProducer);
+	CHECK(sum == kThreads * kItemsPerProducer * (kItemsPerProducer + 1) / 2);
+	uint64_t value = 0;
+	CHECK_FALSE(queue.try_pop(value));
+}
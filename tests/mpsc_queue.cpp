@@ -0,0 +1,77 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/mpsc_queue.hpp>
+
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	struct Item : primal::IntrusiveNode
+	{
+		size_t _producer = 0;
+		size_t _index = 0;
+	};
+}
+
+TEST_CASE("MpscQueue")
+{
+	std::array<Item, 3> items;
+	primal::MpscQueue<Item> queue;
+	CHECK_FALSE(queue.pop());
+	queue.push(&items[0]);
+	CHECK(queue.pop() == &items[0]);
+	CHECK_FALSE(queue.pop());
+	queue.push(&items[1]);
+	queue.push(&items[2]);
+	queue.push(&items[0]); // Popped elements may be pushed again.
+	CHECK(queue.pop() == &items[1]);
+	CHECK(queue.pop() == &items[2]);
+	CHECK(queue.pop() == &items[0]);
+	CHECK_FALSE(queue.pop());
+}
+
+TEST_CASE("MpscQueue stress")
+{
+	constexpr size_t kProducers = 4;
+	constexpr size_t kItemsPerProducer = 50'000;
+	const auto items = std::make_unique<Item[]>(kProducers * kItemsPerProducer);
+	primal::MpscQueue<Item> queue;
+	std::vector<std::thread> producers;
+	for (size_t i = 0; i < kProducers; ++i)
+		producers.emplace_back([&queue, &items, i] {
+			for (size_t j = 0; j < kItemsPerProducer; ++j)
+			{
+				auto& item = items[i * kItemsPerProducer + j];
+				item._producer = i;
+				item._index = j;
+				queue.push(&item);
+			}
+		});
+	std::array<size_t, kProducers> expected{};
+	bool ordered = true;
+	for (size_t received = 0; received < kProducers * kItemsPerProducer;)
+	{
+		const auto item = queue.pop();
+		if (!item)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		ordered &= item->_index == expected[item->_producer]; // Elements from the same producer must arrive in order.
+		expected[item->_producer] = item->_index + 1;
+		++received;
+	}
+	for (auto& producer : producers)
+		producer.join();
+	CHECK(ordered);
+	CHECK_FALSE(queue.pop());
+	for (const auto count : expected)
+		CHECK(count == kItemsPerProducer);
+}
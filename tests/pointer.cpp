@@ -24,6 +24,11 @@ namespace
 			++pointer->_counter;
 	}
 
+	void add(Value* pointer, size_t size) noexcept
+	{
+		pointer->_counter += static_cast<unsigned>(size);
+	}
+
 	struct TaggedDeleter
 	{
 		intptr_t _tag = 0;
@@ -125,6 +130,23 @@ TEST_CASE("CPtr")
 	CHECK(otherValue._counter == expectedOtherValue);
 }
 
+TEST_CASE("SizedFunctionDeleter")
+{
+	using SizedPtr = primal::Pointer<Value, primal::SizedFunctionDeleter<::add>>;
+	Value value;
+	{
+		SizedPtr ptr{ &value, size_t{ 2 } };
+		CHECK(ptr.deleter().size() == 2);
+		SizedPtr otherPtr{ std::move(ptr) };
+		CHECK(ptr.deleter().size() == 0);
+		CHECK(otherPtr.deleter().size() == 2);
+		CHECK(value._counter == 0);
+	}
+	CHECK(value._counter == 2);
+	SizedPtr empty;
+	CHECK(empty.deleter().size() == 0);
+}
+
 TEST_CASE("TaggedPtr")
 {
 	using TaggedPtr = primal::Pointer<Value, TaggedDeleter>;
@@ -0,0 +1,91 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/pool_allocator.hpp>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("PoolAllocator::allocate()")
+{
+	std::vector<void*> pointers;
+	for (size_t size = 0; size <= 2 * primal::PoolAllocator::kMaxSize; ++size)
+	{
+		INFO("size = ", size);
+		const auto pointer = primal::PoolAllocator::allocate(size);
+		REQUIRE(pointer);
+		CHECK(reinterpret_cast<uintptr_t>(pointer) % 16 == 0);
+		std::memset(pointer, 0xff, size);
+		pointers.emplace_back(pointer);
+	}
+	for (const auto pointer : pointers)
+		primal::PoolAllocator::deallocate(pointer);
+	primal::PoolAllocator::deallocate(nullptr);
+}
+
+TEST_CASE("PoolAllocator::deallocate()")
+{
+	const auto first = primal::PoolAllocator::allocate(32);
+	primal::PoolAllocator::deallocate(first);
+	const auto second = primal::PoolAllocator::allocate(32);
+	CHECK(second == first);
+	primal::PoolAllocator::deallocate(second);
+}
+
+namespace
+{
+	// Checks whether the block is reused by the current thread before the pooled memory is exhausted.
+	bool isReused(void* pointer, size_t size)
+	{
+		std::vector<void*> pointers;
+		bool found = false;
+		while (!found && pointers.size() < 65'536)
+		{
+			pointers.emplace_back(primal::PoolAllocator::allocate(size));
+			found = pointers.back() == pointer;
+		}
+		for (const auto allocated : pointers)
+			primal::PoolAllocator::deallocate(allocated);
+		return found;
+	}
+}
+
+TEST_CASE("PoolAllocator cross-thread")
+{
+	constexpr size_t kSize = 64;
+	const auto local = primal::PoolAllocator::allocate(kSize);
+	std::thread{ [local] { primal::PoolAllocator::deallocate(local); } }.join();
+	CHECK(::isReused(local, kSize));
+	void* remote = nullptr;
+	std::thread{ [&remote] { remote = primal::PoolAllocator::allocate(kSize); } }.join();
+	REQUIRE(remote);
+	primal::PoolAllocator::deallocate(remote); // The owning thread has already exited.
+	bool adopted = false;
+	std::thread{ [&adopted, remote] { adopted = ::isReused(remote, kSize); } }.join();
+	CHECK(adopted);
+}
+
+TEST_CASE("PoolAllocator thread exit")
+{
+	struct Guard
+	{
+		bool& _allocated;
+		~Guard()
+		{
+			const auto pointer = primal::PoolAllocator::allocate(32); // The thread's cache has already been released.
+			std::memset(pointer, 0xff, 32);
+			primal::PoolAllocator::deallocate(pointer);
+			_allocated = true;
+		}
+	};
+	bool allocated = false;
+	std::thread{ [&allocated] {
+		static thread_local Guard guard{ allocated };
+		primal::PoolAllocator::deallocate(primal::PoolAllocator::allocate(32));
+	} }.join();
+	CHECK(allocated);
+}
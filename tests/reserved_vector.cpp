@@ -0,0 +1,90 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/reserved_vector.hpp>
+
+#include <array>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	struct Immovable
+	{
+		std::array<int, 255> _padding;
+		int _value;
+
+		explicit Immovable(int value) noexcept
+			: _value{ value } { ++_count; }
+		Immovable(const Immovable&) = delete;
+		~Immovable() noexcept { --_count; }
+		Immovable& operator=(const Immovable&) = delete;
+
+		static inline int _count = 0;
+	};
+
+	static_assert(sizeof(Immovable) == 1024);
+}
+
+TEST_CASE("ReservedVector")
+{
+	constexpr auto kGranularity = primal::ReservedVector<Immovable>::kCommitGranularity;
+	constexpr auto kPerBlock = static_cast<int>(kGranularity / sizeof(Immovable));
+	primal::ReservedVector<Immovable> vector;
+	CHECK_FALSE(vector.data());
+	vector.reserve(size_t{ 1 } << 20); // 1 GiB of address space.
+	const auto data = vector.data();
+	REQUIRE(data);
+	CHECK(vector.capacity() == size_t{ 1 } << 20);
+	CHECK(vector.empty());
+	CHECK(vector.committedBytes() == 0);
+	vector.emplace_back(0);
+	CHECK(vector.committedBytes() == kGranularity);
+	for (int i = 1; i < 3 * kPerBlock; ++i)
+		vector.emplace_back(i);
+	CHECK(vector.committedBytes() == 3 * kGranularity);
+	vector.emplace_back(3 * kPerBlock);
+	CHECK(vector.committedBytes() == 4 * kGranularity);
+	CHECK(Immovable::_count == 3 * kPerBlock + 1);
+	CHECK(vector.data() == data);
+	CHECK(vector.size() == static_cast<size_t>(3 * kPerBlock + 1));
+	int expected = 0;
+	for (const auto& value : vector)
+		CHECK(value._value == expected++);
+	SUBCASE("trim()")
+	{
+		for (int i = 0; i < kPerBlock + 1; ++i)
+			vector.pop_back();
+		CHECK(vector.committedBytes() == 4 * kGranularity);
+		vector.trim();
+		CHECK(vector.committedBytes() == 2 * kGranularity);
+		CHECK(vector.back()._value == 2 * kPerBlock - 1);
+		vector.emplace_back(-1);
+		CHECK(vector.committedBytes() == 3 * kGranularity);
+		CHECK(vector.back()._value == -1);
+	}
+	SUBCASE("clear()")
+	{
+		vector.clear();
+		CHECK(Immovable::_count == 0);
+		CHECK(vector.empty());
+		CHECK(vector.committedBytes() == 4 * kGranularity);
+		vector.emplace_back(1);
+		vector.clear(true);
+		CHECK(vector.committedBytes() == 0);
+		CHECK(&vector.emplace_back(2) == data);
+		CHECK(vector.committedBytes() == kGranularity);
+	}
+	SUBCASE("ReservedVector(ReservedVector&&)")
+	{
+		primal::ReservedVector<Immovable> other{ std::move(vector) };
+		CHECK_FALSE(vector.data());
+		CHECK(vector.capacity() == 0);
+		CHECK(vector.committedBytes() == 0);
+		CHECK(other.data() == data);
+		CHECK(other.committedBytes() == 4 * kGranularity);
+	}
+	vector = {};
+	CHECK(Immovable::_count == 0);
+}
@@ -4,6 +4,7 @@
 
 #include <primal/rigid_vector.hpp>
 
+#include <string>
 #include <vector>
 
 #include <doctest/doctest.h>
@@ -12,6 +13,32 @@ namespace
 {
 	using RigidVector = primal::RigidVector<int, primal::Allocator>;
 
+	// Allocator with state which counts allocated bytes.
+	class CountingAllocator
+	{
+	public:
+		explicit CountingAllocator(size_t& counter) noexcept
+			: _counter{ &counter } {}
+
+		[[nodiscard]] void* allocate(size_t size)
+		{
+			*_counter += size;
+			return primal::Allocator::allocate(size);
+		}
+
+		void deallocate(void* memory) noexcept
+		{
+			primal::Allocator::deallocate(memory);
+		}
+
+	private:
+		size_t* _counter;
+	};
+
+#ifdef NDEBUG
+	static_assert(sizeof(RigidVector) == 2 * sizeof(void*));
+#endif
+
 	void check(RigidVector& vector, const std::vector<int>& expected, bool allocated = true)
 	{
 		CHECK(vector.empty() == expected.empty());
@@ -139,3 +166,74 @@ TEST_CASE("RigidVector")
 		}
 	}
 }
+
+TEST_CASE("RigidVector bulk construction")
+{
+	RigidVector vector;
+	vector.reserve(10);
+	SUBCASE("append()")
+	{
+		const int values[]{ 1, 2, 3 };
+		vector.append(values, 3);
+		::check(vector, { 1, 2, 3 });
+		vector.append(nullptr, 0);
+		vector.append(values + 1, 2);
+		::check(vector, { 1, 2, 3, 2, 3 });
+	}
+	SUBCASE("emplace_n()")
+	{
+		vector.emplace_n(2);
+		::check(vector, { 0, 0 });
+		vector.emplace_n(3, 7);
+		::check(vector, { 0, 0, 7, 7, 7 });
+		vector.emplace_n(0, 1);
+		::check(vector, { 0, 0, 7, 7, 7 });
+	}
+	SUBCASE("resize_uninitialized()")
+	{
+		vector.emplace_back(1);
+		vector.resize_uninitialized(3);
+		CHECK(vector.size() == 3);
+		vector[1] = 2;
+		vector[2] = 3;
+		::check(vector, { 1, 2, 3 });
+		vector.resize_uninitialized(1);
+		::check(vector, { 1 });
+	}
+}
+
+TEST_CASE("RigidVector::emplace_n() with nontrivial types")
+{
+	struct Named
+	{
+		std::string _name;
+		int _value;
+	};
+
+	primal::RigidVector<Named> vector;
+	vector.reserve(4);
+	vector.emplace_n(3, "name", 5);
+	REQUIRE(vector.size() == 3);
+	for (const auto& element : vector)
+	{
+		CHECK(element._name == "name");
+		CHECK(element._value == 5);
+	}
+	vector.clear();
+	CHECK(vector.empty());
+}
+
+TEST_CASE("RigidVector with a stateful allocator")
+{
+	size_t counter = 0;
+	primal::RigidVector<int, CountingAllocator> vector{ CountingAllocator{ counter } };
+	vector.reserve(2);
+	CHECK(counter == 2 * sizeof(int));
+	vector.emplace_back(1);
+	primal::RigidVector<int, CountingAllocator> other{ std::move(vector) };
+	CHECK(other.size() == 1);
+	CHECK(other[0] == 1);
+	primal::RigidVector<int, CountingAllocator> copied{ other.allocator() };
+	copied.reserve(1);
+	CHECK(counter == 3 * sizeof(int));
+}
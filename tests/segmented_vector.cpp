@@ -0,0 +1,118 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/segmented_vector.hpp>
+
+#include <vector>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	struct Immovable
+	{
+		int _value;
+
+		explicit Immovable(int value) noexcept
+			: _value{ value } { ++_count; }
+		Immovable(const Immovable&) = delete;
+		~Immovable() noexcept { --_count; }
+		Immovable& operator=(const Immovable&) = delete;
+
+		static inline int _count = 0;
+	};
+}
+
+TEST_CASE("SegmentedVector")
+{
+	using Vector = primal::SegmentedVector<Immovable, primal::Allocator, 4>;
+	Vector vector;
+	CHECK(vector.empty());
+	CHECK(vector.begin() == vector.end());
+	CHECK(vector.capacity() == 0);
+	std::vector<const Immovable*> addresses;
+	for (int i = 0; i < 100; ++i)
+	{
+		addresses.emplace_back(&vector.emplace_back(i));
+		CHECK(vector.back()._value == i);
+	}
+	CHECK(Immovable::_count == 100);
+	CHECK(vector.size() == 100);
+	CHECK(vector.segmentCount() == 5); // 4 + 8 + 16 + 32 + 64.
+	CHECK(vector.capacity() == 124);
+	for (size_t i = 0; i < 100; ++i)
+	{
+		CHECK(&vector[i] == addresses[i]);
+		CHECK(vector[i]._value == static_cast<int>(i));
+	}
+	SUBCASE("iteration")
+	{
+		int expected = 0;
+		for (const auto& value : std::as_const(vector))
+			CHECK(value._value == expected++);
+		CHECK(expected == 100);
+	}
+	SUBCASE("segment()")
+	{
+		int expected = 0;
+		for (size_t i = 0; i < vector.segmentCount(); ++i)
+		{
+			const auto segment = vector.segment(i);
+			CHECK(segment.size() == (i < 4 ? size_t{ 4 } << i : 100 - 60));
+			for (const auto& value : segment)
+				CHECK(value._value == expected++);
+		}
+		CHECK(expected == 100);
+	}
+	SUBCASE("pop_back()")
+	{
+		for (int i = 0; i < 40; ++i)
+			vector.pop_back();
+		CHECK(Immovable::_count == 60);
+		CHECK(vector.size() == 60);
+		CHECK(vector.back()._value == 59);
+		CHECK(vector.segment(4).empty());
+		int expected = 0;
+		for (const auto& value : vector)
+			CHECK(value._value == expected++);
+		CHECK(expected == 60);
+	}
+	SUBCASE("clear()")
+	{
+		vector.clear();
+		CHECK(Immovable::_count == 0);
+		CHECK(vector.empty());
+		CHECK(vector.begin() == vector.end());
+		CHECK(vector.capacity() == 124);
+		CHECK(&vector.emplace_back(1) == addresses[0]);
+	}
+	SUBCASE("SegmentedVector(SegmentedVector&&)")
+	{
+		Vector other{ std::move(vector) };
+		CHECK(vector.empty());
+		CHECK(vector.segmentCount() == 0);
+		CHECK(other.size() == 100);
+		CHECK(&other[99] == addresses[99]);
+	}
+	vector = {};
+	CHECK(Immovable::_count == 0);
+}
+
+TEST_CASE("SegmentedVector::reserve()")
+{
+	primal::SegmentedVector<int> vector;
+	vector.reserve(17);
+	CHECK(vector.capacity() == 48);
+	CHECK(vector.segmentCount() == 2);
+	CHECK(vector.empty());
+	CHECK(vector.begin() == vector.end());
+	for (int i = 0; i < 16; ++i)
+		vector.emplace_back(i);
+	CHECK(vector.segment(0).size() == 16);
+	CHECK(vector.segment(1).empty());
+	int expected = 0;
+	for (const auto value : vector)
+		CHECK(value == expected++);
+	CHECK(expected == 16);
+}
@@ -0,0 +1,166 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/slot_map.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	// Allocator with state which counts allocations.
+	class CountingAllocator
+	{
+	public:
+		explicit CountingAllocator(size_t& counter) noexcept
+			: _counter{ &counter } {}
+
+		[[nodiscard]] void* allocate(size_t size)
+		{
+			++*_counter;
+			return primal::Allocator::allocate(size);
+		}
+
+		void deallocate(void* memory) noexcept
+		{
+			primal::Allocator::deallocate(memory);
+		}
+
+	private:
+		size_t* _counter;
+	};
+}
+
+TEST_CASE("SlotMap")
+{
+	using SlotMap = primal::SlotMap<std::string>;
+	SlotMap map;
+	CHECK(map.empty());
+	CHECK(map.capacity() == 0);
+	CHECK_FALSE(map.find({}));
+	CHECK_FALSE(map.erase({}));
+	const auto one = map.emplace("one");
+	const auto two = map.emplace("two");
+	const auto three = map.emplace("three");
+	CHECK(map.size() == 3);
+	CHECK(map.capacity() == 16);
+	CHECK(one != two);
+	CHECK(*map.find(one) == "one");
+	CHECK(*map.find(two) == "two");
+	CHECK(*map.find(three) == "three");
+	CHECK_FALSE(map.contains({}));
+	SUBCASE("erase()")
+	{
+		CHECK(map.erase(one));
+		CHECK_FALSE(map.erase(one));
+		CHECK(map.size() == 2);
+		CHECK_FALSE(map.find(one));
+		CHECK(map.data()[0] == "three"); // The last element is moved into the erased place.
+		CHECK(map.handle(0) == three);
+		CHECK(*map.find(three) == "three");
+		const auto four = map.emplace("four"); // Reuses the slot of the erased element.
+		CHECK(four.value() != one.value());
+		CHECK_FALSE(map.find(one));
+		CHECK(*map.find(four) == "four");
+	}
+	SUBCASE("clear()")
+	{
+		map.clear();
+		CHECK(map.empty());
+		CHECK(map.capacity() == 16);
+		CHECK(map.begin() == map.end());
+		CHECK_FALSE(map.find(one));
+		CHECK_FALSE(map.find(two));
+		CHECK_FALSE(map.find(three));
+		const auto four = map.emplace("four");
+		CHECK_FALSE(map.find(one));
+		CHECK(*map.find(four) == "four");
+	}
+	SUBCASE("SlotMap(SlotMap&&)")
+	{
+		auto other = std::move(map);
+		CHECK(map.empty());
+		CHECK_FALSE(map.find(one));
+		CHECK(*other.find(two) == "two");
+		CHECK(*other.find(SlotMap::Handle{ three.value() }) == "three");
+	}
+}
+
+TEST_CASE("SlotMap random")
+{
+	primal::SlotMap<std::unique_ptr<int>, primal::Allocator, uint32_t> map;
+	std::map<uint32_t, int> reference;
+	uint32_t random = 1;
+	for (int i = 0; i < 100'000; ++i)
+	{
+		random = random * 1664525 + 1013904223;
+		if (reference.empty() || (random & 0x8000 && map.size() < 1000))
+		{
+			const auto handle = map.emplace(std::make_unique<int>(i));
+			CHECK(reference.emplace(handle.value(), i).second);
+		}
+		else
+		{
+			const auto entry = std::next(reference.begin(), static_cast<ptrdiff_t>((random >> 16) % reference.size()));
+			CHECK(map.erase(decltype(map)::Handle{ entry->first }));
+			reference.erase(entry);
+		}
+	}
+	CHECK(map.size() == reference.size());
+	for (const auto& [handle, value] : reference)
+	{
+		const auto found = map.find(decltype(map)::Handle{ handle });
+		REQUIRE(found);
+		CHECK(**found == value);
+	}
+	for (size_t i = 0; i < map.size(); ++i)
+		CHECK(reference.at(map.handle(i).value()) == *map.data()[i]);
+}
+
+TEST_CASE("SlotMap with a stateful allocator")
+{
+	size_t counter = 0;
+	primal::SlotMap<int, CountingAllocator> map{ CountingAllocator{ counter } };
+	const auto handle = map.emplace(1);
+	CHECK(counter == 3); // Values, value slots and slots.
+	primal::SlotMap<int, CountingAllocator> other{ std::move(map) };
+	CHECK(*other.find(handle) == 1);
+	primal::SlotMap<int, CountingAllocator> copied{ other.allocator() };
+	copied.reserve(1);
+	CHECK(counter == 6);
+}
+
+TEST_CASE("SlotMap::emplace() with an existing value")
+{
+	primal::SlotMap<std::string> map;
+	const std::string value(100, 'a'); // Too long for the small string optimization.
+	const auto handle = map.emplace(value);
+	while (map.size() < map.capacity())
+		map.emplace(value);
+	const auto capacity = map.capacity();
+	const auto copy = map.emplace(*map.find(handle));
+	CHECK(map.capacity() > capacity);
+	CHECK(*map.find(copy) == value);
+	CHECK(*map.find(handle) == value);
+}
+
+TEST_CASE("SlotMap::kMaxSize")
+{
+	using SlotMap = primal::SlotMap<char, primal::Allocator, uint32_t>;
+	SlotMap map;
+	SlotMap::Handle last;
+	for (size_t i = 0; i < SlotMap::kMaxSize; ++i)
+		last = map.emplace('a');
+	CHECK(map.size() == SlotMap::kMaxSize);
+	CHECK((last.value() & 0xffff) == SlotMap::kMaxSize - 1);
+	CHECK_THROWS_AS(map.emplace('b'), std::bad_alloc);
+	CHECK(map.size() == SlotMap::kMaxSize);
+	CHECK(map.erase(last));
+	const auto reused = map.emplace('c');
+	CHECK(*map.find(reused) == 'c');
+	CHECK_THROWS_AS(map.reserve(SlotMap::kMaxSize + 1), std::bad_alloc);
+}
@@ -0,0 +1,168 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/small_vector.hpp>
+
+#include <new>
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	using SmallVector = primal::SmallVector<int, 2>;
+
+	// Allocator which counts allocated blocks.
+	class CountingAllocator
+	{
+	public:
+		static inline int _blocks = 0;
+
+		[[nodiscard]] static void* allocate(size_t size)
+		{
+			const auto memory = primal::Allocator::allocate(size);
+			++_blocks;
+			return memory;
+		}
+
+		static void deallocate(void* memory) noexcept
+		{
+			if (memory)
+				--_blocks;
+			primal::Allocator::deallocate(memory);
+		}
+	};
+
+	// Type which throws when copying a negative value.
+	struct ThrowingCopy
+	{
+		int _value;
+
+		constexpr ThrowingCopy(int value) noexcept
+			: _value{ value } {}
+		ThrowingCopy(ThrowingCopy&&) noexcept = default;
+
+		ThrowingCopy(const ThrowingCopy& other)
+			: _value{ other._value }
+		{
+			if (_value < 0)
+				throw std::bad_alloc{};
+		}
+	};
+
+	void check(SmallVector& vector, const std::vector<int>& expected)
+	{
+		CHECK(vector.empty() == expected.empty());
+		CHECK(vector.size() == expected.size());
+		CHECK(vector.capacity() >= vector.size());
+		auto it = vector.begin();
+		auto cit = vector.cbegin();
+		auto data = vector.data();
+		CHECK(data);
+		CHECK(std::as_const(vector).begin() == cit);
+		CHECK(std::as_const(vector).data() == data);
+		for (size_t index = 0; index < expected.size(); ++index)
+		{
+			INFO('[', index, ']');
+			REQUIRE(it < vector.end());
+			REQUIRE(cit < vector.cend());
+			const auto value = expected[index];
+			CHECK(*it == value);
+			CHECK(*cit == value);
+			CHECK(*data == value);
+			CHECK(vector[index] == value);
+			CHECK(std::as_const(vector)[index] == value);
+			++it;
+			++cit;
+			++data;
+		}
+		CHECK(vector.end() == it);
+		CHECK(vector.cend() == cit);
+		CHECK(std::as_const(vector).end() == cit);
+		if (!expected.empty())
+		{
+			const auto value = expected.back();
+			CHECK(vector.back() == value);
+			CHECK(std::as_const(vector).back() == value);
+		}
+	}
+}
+
+TEST_CASE("SmallVector")
+{
+	SmallVector vector;
+	::check(vector, {});
+	CHECK(vector.isInline());
+	CHECK(vector.capacity() == 2);
+	vector.emplace_back(1);
+	vector.emplace_back(2);
+	::check(vector, { 1, 2 });
+	CHECK(vector.isInline());
+	SUBCASE("emplace_back()")
+	{
+		vector.emplace_back(3);
+		::check(vector, { 1, 2, 3 });
+		CHECK_FALSE(vector.isInline());
+		CHECK(vector.capacity() == 4);
+		vector.emplace_back(vector[0]);
+		vector.emplace_back(vector[1]);
+		::check(vector, { 1, 2, 3, 1, 2 });
+		CHECK(vector.capacity() == 8);
+		SUBCASE("clear()")
+		{
+			vector.clear();
+			::check(vector, {});
+			CHECK_FALSE(vector.isInline());
+			CHECK(vector.capacity() == 8);
+		}
+		SUBCASE("pop_back()")
+		{
+			vector.pop_back();
+			::check(vector, { 1, 2, 3, 1 });
+		}
+	}
+	SUBCASE("pop_back()")
+	{
+		vector.pop_back();
+		::check(vector, { 1 });
+		vector.pop_back();
+		::check(vector, {});
+	}
+	SUBCASE("reserve()")
+	{
+		vector.reserve(2);
+		CHECK(vector.isInline());
+		vector.reserve(10);
+		CHECK_FALSE(vector.isInline());
+		CHECK(vector.capacity() == 10);
+		::check(vector, { 1, 2 });
+	}
+}
+
+TEST_CASE("SmallVector(std::initializer_list)")
+{
+	SmallVector small{ 1, 2 };
+	CHECK(small.isInline());
+	::check(small, { 1, 2 });
+	SmallVector large{ 1, 2, 3, 4, 5 };
+	CHECK_FALSE(large.isInline());
+	::check(large, { 1, 2, 3, 4, 5 });
+	using ThrowingVector = primal::SmallVector<ThrowingCopy, 1, CountingAllocator>;
+	CHECK_THROWS_AS((ThrowingVector{ 1, 2, -3 }), std::bad_alloc);
+	CHECK(CountingAllocator::_blocks == 0);
+}
+
+TEST_CASE("SmallVector with nontrivial types")
+{
+	primal::SmallVector<std::string, 1, primal::Allocator, 16> vector;
+	CHECK(reinterpret_cast<uintptr_t>(vector.data()) % 16 == 0);
+	vector.emplace_back(std::string(100, 'a'));
+	vector.emplace_back(vector[0]);
+	vector.emplace_back("b");
+	REQUIRE(vector.size() == 3);
+	CHECK(vector[0] == std::string(100, 'a'));
+	CHECK(vector[1] == vector[0]);
+	CHECK(vector[2] == "b");
+}
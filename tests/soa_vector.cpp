@@ -0,0 +1,95 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/soa_vector.hpp>
+
+#include <cstdint>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	struct Counted
+	{
+		int _value;
+
+		Counted(int value) noexcept
+			: _value{ value } { ++_count; }
+		Counted(const Counted&) = delete;
+		~Counted() noexcept { --_count; }
+		Counted& operator=(const Counted&) = delete;
+
+		static inline int _count = 0;
+	};
+}
+
+TEST_CASE("SoaVector")
+{
+	primal::SoaVector<float, uint8_t, Counted> vector;
+	CHECK(vector.empty());
+	CHECK(vector.begin() == vector.end());
+	vector.reserve(5);
+	for (int i = 0; i < 5; ++i)
+	{
+		const auto [x, flag, counted] = vector.emplace_back(static_cast<float>(i), static_cast<uint8_t>(i % 2), i);
+		CHECK(x == static_cast<float>(i));
+		CHECK(flag == i % 2);
+		CHECK(counted._value == i);
+	}
+	CHECK(Counted::_count == 5);
+	REQUIRE(vector.size() == 5);
+	const auto xs = vector.column<0>();
+	REQUIRE(xs.size() == 5);
+	CHECK(reinterpret_cast<uintptr_t>(xs.data()) % primal::kDspAlignment == 0);
+	CHECK(reinterpret_cast<uintptr_t>(vector.column<1>().data()) % primal::kDspAlignment == 0);
+	CHECK(xs[4] == 4.f);
+	CHECK(vector.column<1>()[3] == 1);
+	CHECK(std::as_const(vector).column<2>()[2]._value == 2);
+	SUBCASE("iteration")
+	{
+		int expected = 0;
+		for (auto [x, flag, counted] : vector)
+		{
+			CHECK(x == static_cast<float>(expected));
+			flag = 7;
+			CHECK(counted._value == expected++);
+		}
+		CHECK(expected == 5);
+		for (const auto flag : std::as_const(vector).column<1>())
+			CHECK(flag == 7);
+	}
+	SUBCASE("operator[]")
+	{
+		std::get<0>(vector[1]) = 10.f;
+		CHECK(xs[1] == 10.f);
+		CHECK(std::get<2>(std::as_const(vector)[3])._value == 3);
+		CHECK(std::get<0>(vector.back()) == 4.f);
+	}
+	SUBCASE("pop_back()")
+	{
+		vector.pop_back();
+		CHECK(Counted::_count == 4);
+		CHECK(vector.size() == 4);
+		CHECK(std::get<2>(vector.back())._value == 3);
+	}
+	SUBCASE("clear()")
+	{
+		vector.clear();
+		CHECK(Counted::_count == 0);
+		CHECK(vector.empty());
+		CHECK(vector.begin() == vector.end());
+		vector.emplace_back(1.f, uint8_t{ 1 }, 1);
+		CHECK(vector.column<0>().data() == xs.data());
+	}
+	SUBCASE("SoaVector(SoaVector&&)")
+	{
+		primal::SoaVector<float, uint8_t, Counted> other{ std::move(vector) };
+		CHECK(vector.empty());
+		CHECK(vector.column<0>().data() == nullptr);
+		CHECK(other.size() == 5);
+		CHECK(other.column<0>().data() == xs.data());
+	}
+	vector = {};
+	CHECK(Counted::_count == 0);
+}
@@ -0,0 +1,90 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/spsc_ring.hpp>
+
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("SpscRing")
+{
+	primal::SpscRing<int> ring{ 6 };
+	REQUIRE(ring.capacity() == 8);
+	CHECK(ring.readable().empty());
+	CHECK(ring.writable().size() == 8);
+	std::array<int, 10> input{};
+	std::iota(input.begin(), input.end(), 1);
+	CHECK(ring.write({ input.data(), 5 }) == 5);
+	CHECK(ring.writable().size() == 3);
+	std::array<int, 10> output{};
+	CHECK(ring.read({ output.data(), 3 }) == 3);
+	CHECK(output[0] == 1);
+	CHECK(output[2] == 3);
+	CHECK(ring.write(input) == 6); // Wraps around.
+	CHECK(ring.writable().empty());
+	CHECK(ring.readable().size() == 5);
+	CHECK(ring.read(output) == 8);
+	CHECK(output[0] == 4);
+	CHECK(output[1] == 5);
+	CHECK(output[2] == 1);
+	CHECK(output[7] == 6);
+	CHECK(ring.readable().empty());
+}
+
+TEST_CASE("SpscRing::writable()")
+{
+	primal::SpscRing<float> ring{ 64 };
+	for (size_t i = 0; i < 100; ++i)
+	{
+		const auto writable = ring.writable();
+		REQUIRE(writable.size() >= ring.kGranularity);
+		CHECK(reinterpret_cast<uintptr_t>(writable.data()) % primal::kDspAlignment == 0);
+		writable[0] = static_cast<float>(i);
+		ring.commitWrite(ring.kGranularity);
+		const auto readable = ring.readable();
+		REQUIRE(readable.size() == ring.kGranularity);
+		CHECK(reinterpret_cast<uintptr_t>(readable.data()) % primal::kDspAlignment == 0);
+		CHECK(readable[0] == static_cast<float>(i));
+		ring.commitRead(readable.size());
+	}
+}
+
+TEST_CASE("SpscRing (threads)")
+{
+	constexpr uint32_t kCount = 1'000'000;
+	primal::SpscRing<uint32_t> ring{ 1024 };
+	std::thread producer{ [&ring] {
+		std::array<uint32_t, 100> block{};
+		for (uint32_t next = 0; next < kCount;)
+		{
+			const auto size = std::min<size_t>(block.size(), kCount - next);
+			for (size_t i = 0; i < size; ++i)
+				block[i] = next + static_cast<uint32_t>(i);
+			for (size_t written = 0; written < size;)
+			{
+				written += ring.write({ block.data() + written, size - written });
+				std::this_thread::yield();
+			}
+			next += static_cast<uint32_t>(size);
+		}
+	} };
+	uint32_t expected = 0;
+	bool ordered = true;
+	while (expected < kCount)
+	{
+		const auto readable = ring.readable();
+		for (const auto value : readable)
+			ordered = ordered && value == expected++;
+		ring.commitRead(readable.size());
+		if (readable.empty())
+			std::this_thread::yield();
+	}
+	producer.join();
+	CHECK(ordered);
+	CHECK(ring.readable().empty());
+}
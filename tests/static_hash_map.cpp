@@ -0,0 +1,124 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/static_hash_map.hpp>
+
+#include <map>
+#include <string>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	// Hash which puts all keys into the same probe sequence.
+	struct CollidingHash
+	{
+		size_t operator()(int) const noexcept { return 0; }
+	};
+}
+
+TEST_CASE("StaticHashMap")
+{
+	primal::StaticHashMap<int, std::string, 4> map;
+	static_assert(decltype(map)::kSlotCount == 8);
+	CHECK(map.empty());
+	CHECK(map.begin() == map.end());
+	CHECK_FALSE(map.find(1));
+	CHECK_FALSE(map.erase(1));
+	const auto [value, inserted] = map.try_emplace(1, "one");
+	CHECK(inserted);
+	REQUIRE(value);
+	CHECK(*value == "one");
+	CHECK(map.size() == 1);
+	const auto [existing, insertedAgain] = map.try_emplace(1, "uno");
+	CHECK_FALSE(insertedAgain);
+	CHECK(existing == value);
+	CHECK(*existing == "one");
+	map[2] = "two";
+	CHECK(map.size() == 2);
+	CHECK(map.contains(2));
+	CHECK_FALSE(map.contains(3));
+	SUBCASE("erase()")
+	{
+		CHECK(map.erase(1));
+		CHECK_FALSE(map.erase(1));
+		CHECK(map.size() == 1);
+		CHECK_FALSE(map.find(1));
+		CHECK(*map.find(2) == "two");
+	}
+	SUBCASE("iteration")
+	{
+		size_t count = 0;
+		for (const auto [key, mapped] : std::as_const(map))
+		{
+			CHECK(mapped == (key == 1 ? "one" : "two"));
+			++count;
+		}
+		CHECK(count == 2);
+		for (auto [key, mapped] : map)
+			mapped += '!';
+		CHECK(*map.find(1) == "one!");
+	}
+	SUBCASE("clear()")
+	{
+		map.clear();
+		CHECK(map.empty());
+		CHECK(map.begin() == map.end());
+		CHECK_FALSE(map.find(1));
+	}
+	SUBCASE("full")
+	{
+		map[3] = "three";
+		map[4] = "four";
+		CHECK(map.size() == 4);
+		for (int i = 1; i <= 4; ++i)
+			CHECK(map.contains(i));
+	}
+}
+
+TEST_CASE("StaticHashMap collisions")
+{
+	primal::StaticHashMap<int, int, 32, CollidingHash> map;
+	for (int i = 0; i < 32; ++i)
+		map[i] = i;
+	for (int i = 0; i < 32; i += 2)
+		CHECK(map.erase(i));
+	for (int i = 0; i < 32; ++i)
+	{
+		const auto value = map.find(i);
+		CHECK(static_cast<bool>(value) == (i % 2 == 1));
+		if (value)
+			CHECK(*value == i);
+	}
+}
+
+TEST_CASE("StaticHashMap random")
+{
+	primal::StaticHashMap<int, int, 48> map;
+	std::map<int, int> reference;
+	uint32_t random = 1;
+	for (int i = 0; i < 100'000; ++i)
+	{
+		random = random * 1664525 + 1013904223;
+		const auto key = static_cast<int>(random >> 26); // Up to 64 distinct keys.
+		if ((random & 0x8000) && reference.size() < 48)
+			CHECK(map.try_emplace(key, i).second == reference.emplace(key, i).second);
+		else
+			CHECK(map.erase(key) == (reference.erase(key) > 0));
+	}
+	CHECK(map.size() == reference.size());
+	for (const auto& [key, value] : reference)
+	{
+		const auto found = map.find(key);
+		REQUIRE(found);
+		CHECK(*found == value);
+	}
+	size_t count = 0;
+	for (const auto [key, value] : map)
+	{
+		CHECK(reference.at(key) == value);
+		++count;
+	}
+	CHECK(count == reference.size());
+}
@@ -4,6 +4,8 @@
 
 #include <primal/static_vector.hpp>
 
+#include <cstring>
+#include <string>
 #include <vector>
 
 #include <doctest/doctest.h>
@@ -79,3 +81,46 @@ TEST_CASE("StaticVector")
 		}
 	}
 }
+
+TEST_CASE("StaticVector with nontrivial types")
+{
+	primal::StaticVector<std::string, 2> vector{ "a", "b", "c" };
+	static_assert(!std::is_trivially_copyable_v<decltype(vector)>);
+	REQUIRE(vector.size() == 2);
+	CHECK(vector[0] == "a");
+	CHECK(vector.back() == "b");
+	vector.pop_back();
+	vector.emplace_back(std::string(3, 'c'));
+	CHECK(vector.back() == "ccc");
+	vector.clear();
+	CHECK(vector.empty());
+}
+
+TEST_CASE("StaticVector with trivial types")
+{
+	static_assert(std::is_trivially_copyable_v<StaticVector>);
+	static constexpr auto table = [] {
+		primal::StaticVector<int, 4> result{ 1, 2 };
+		result.emplace_back(3);
+		return result;
+	}();
+	static_assert(table.size() == 3);
+	static_assert(table[2] == 3);
+	static_assert(table.back() == 3);
+	static_assert(std::is_copy_constructible_v<StaticVector> && std::is_copy_assignable_v<StaticVector>);
+	auto copy = table;
+	copy.pop_back();
+	copy.emplace_back(4);
+	CHECK(copy.back() == 4);
+	CHECK(table.back() == 3);
+	primal::StaticVector<int, 4> copied;
+	std::memcpy(&copied, &copy, sizeof copy);
+	REQUIRE(copied.size() == 3);
+	CHECK(copied[0] == 1);
+	CHECK(copied[2] == 4);
+	copied = primal::StaticVector<int, 4>{ 5 };
+	REQUIRE(copied.size() == 1);
+	CHECK(copied[0] == 5);
+	primal::StaticVector<float, 4, 16> aligned;
+	CHECK(reinterpret_cast<uintptr_t>(aligned.data()) % 16 == 0);
+}
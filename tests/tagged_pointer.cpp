@@ -0,0 +1,36 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/tagged_pointer.hpp>
+
+#include <atomic>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("TaggedPointer")
+{
+	using TaggedPointer = primal::TaggedPointer<int>;
+	static_assert(sizeof(TaggedPointer) == 8);
+	static_assert(std::atomic<TaggedPointer>::is_always_lock_free);
+
+	const TaggedPointer null;
+	CHECK_FALSE(null.pointer());
+	CHECK(null.tag() == 0);
+
+	int value = 0;
+	const TaggedPointer tagged{ &value, 1 };
+	CHECK(tagged.pointer() == &value);
+	CHECK(tagged.tag() == 1);
+	CHECK(tagged != null);
+	CHECK(tagged != TaggedPointer{ &value, 2 });
+	CHECK(tagged == TaggedPointer{ &value, 1 });
+
+	constexpr auto kMaxTag = static_cast<uint32_t>((uint64_t{ 1 } << TaggedPointer::kTagBits) - 1);
+	const TaggedPointer maxTagged{ &value, kMaxTag };
+	CHECK(maxTagged.pointer() == &value);
+	CHECK(maxTagged.tag() == kMaxTag);
+	const TaggedPointer wrapped{ &value, maxTagged.tag() + 1 }; // Tags wrap around.
+	CHECK(wrapped.pointer() == &value);
+	CHECK(wrapped.tag() == 0);
+}
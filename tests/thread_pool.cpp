@@ -0,0 +1,86 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/thread_pool.hpp>
+
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("ThreadPool::parallel_for()")
+{
+	for (const size_t workerCount : { 0u, 1u, 3u })
+	{
+		INFO("workerCount = " << workerCount);
+		primal::ThreadPool pool{ workerCount };
+		CHECK(pool.workerCount() == workerCount);
+		for (const size_t size : { 0u, 1u, 7u, 8u, 9u, 1000u })
+		{
+			INFO("size = " << size);
+			const auto counts = std::make_unique<std::atomic<int>[]>(size + 10);
+			std::atomic<bool> misaligned{ false };
+			pool.parallel_for(10, 10 + size, 8, [&](size_t first, size_t last) {
+				if (first >= last || last - first > 8 || (first - 10) % 8)
+					misaligned = true;
+				for (auto i = first; i < last; ++i)
+					++counts[i];
+			});
+			CHECK_FALSE(misaligned);
+			for (size_t i = 0; i < size + 10; ++i)
+				CHECK(counts[i] == (i >= 10 ? 1 : 0));
+		}
+	}
+}
+
+TEST_CASE("TaskGroup")
+{
+	primal::ThreadPool pool{ 2 };
+	std::atomic<int> sum{ 0 };
+	{
+		primal::TaskGroup group{ pool };
+		for (int i = 1; i <= 100; ++i)
+			group.run([&sum, i] { sum += i; });
+		group.wait();
+		CHECK(sum == 5050);
+		SUBCASE("nested")
+		{
+			for (int i = 0; i < 10; ++i)
+				group.run([&pool, &sum] {
+					primal::TaskGroup nested{ pool };
+					for (int j = 0; j < 10; ++j)
+						nested.run([&sum] { ++sum; });
+				});
+			group.wait();
+			CHECK(sum == 5150);
+		}
+		SUBCASE("parallel_for() in tasks")
+		{
+			std::vector<int> values(10'000, 1);
+			for (int i = 0; i < 4; ++i)
+				group.run([&pool, &values, &sum] {
+					std::atomic<int> partial{ 0 };
+					pool.parallel_for(0, values.size(), 64, [&values, &partial](size_t first, size_t last) {
+						partial += std::accumulate(values.begin() + static_cast<ptrdiff_t>(first), values.begin() + static_cast<ptrdiff_t>(last), 0);
+					});
+					sum += partial;
+				});
+			group.wait();
+			CHECK(sum == 45050);
+		}
+	}
+}
+
+TEST_CASE("TaskGroup overflow")
+{
+	primal::ThreadPool pool{ 1 };
+	std::atomic<int> count{ 0 };
+	primal::TaskGroup group{ pool };
+	for (int i = 0; i < 10'000; ++i) // More than fits in the queue, so some tasks are executed inline.
+		group.run([&count] { ++count; });
+	group.wait();
+	CHECK(count == 10'000);
+}
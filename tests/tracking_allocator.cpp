@@ -0,0 +1,60 @@
+// This file is part of the Primal library.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <primal/tracking_allocator.hpp>
+
+#include <primal/buffer.hpp>
+
+#include <thread>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	struct Tag;
+	struct OtherTag;
+
+	using Allocator = primal::TrackingAllocator<primal::Allocator, Tag>;
+	using AlignedAllocator = primal::TrackingAllocator<primal::AlignedAllocator<64>, Tag>;
+}
+
+TEST_CASE("TrackingAllocator")
+{
+	auto stats = Allocator::snapshot();
+	CHECK(stats.liveBytes == 0);
+	CHECK(stats.peakBytes == 0);
+	CHECK(stats.allocations == 0);
+	{
+		primal::Buffer<std::byte, Allocator> first{ 1 };
+		primal::Buffer<std::byte, AlignedAllocator> second{ 100 };
+		CHECK(reinterpret_cast<uintptr_t>(second.data()) % 64 == 0);
+		stats = Allocator::snapshot();
+		CHECK(stats.liveBytes == 101);
+		CHECK(stats.peakBytes == 101);
+		CHECK(stats.allocations == 2);
+		CHECK(stats.deallocations == 0);
+		CHECK(stats.sizeHistogram[1] == 1);
+		CHECK(stats.sizeHistogram[7] == 1);
+		std::thread{ [buffer = std::move(second)] {} }.join();
+		CHECK(Allocator::snapshot().liveBytes == 1);
+	}
+	stats = Allocator::snapshot();
+	CHECK(stats.liveBytes == 0);
+	CHECK(stats.allocations == 2);
+	CHECK(stats.deallocations == 2);
+	CHECK(primal::TrackingAllocator<primal::Allocator, OtherTag>::snapshot().allocations == 0);
+}
+
+TEST_CASE("TrackingAllocator peak")
+{
+	using LargeAllocator = primal::TrackingAllocator<primal::Allocator, OtherTag>;
+	constexpr auto kSize = 2 * primal::AllocationTracker<OtherTag>::kPeakPrecision;
+	{
+		primal::Buffer<std::byte, LargeAllocator> first{ kSize };
+		primal::Buffer<std::byte, LargeAllocator> second{ kSize };
+	}
+	const auto stats = LargeAllocator::snapshot();
+	CHECK(stats.liveBytes == 0);
+	CHECK(stats.peakBytes == 2 * kSize);
+}